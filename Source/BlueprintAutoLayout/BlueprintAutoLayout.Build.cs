@@ -8,6 +8,9 @@ public class BlueprintAutoLayout : ModuleRules
   {
     PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
 
+    // Layout trace output (LAYOUT_LOG); set to 0 to compile it out entirely.
+    PublicDefinitions.Add("BLUEPRINTAUTOLAYOUT_TRACE=1");
+
     PublicDependencyModuleNames.AddRange(
       new[]
       {
@@ -21,6 +24,7 @@ public class BlueprintAutoLayout : ModuleRules
       new[]
       {
         "ApplicationCore",
+        "AssetRegistry",
         "BlueprintGraph",
         "EditorSubsystem",
         "GraphEditor",
@@ -0,0 +1,206 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Commandlet definition.
+#include "BlueprintAutoLayoutBenchmarkCommandlet.h"
+
+// Benchmark runner, logging, and golden file I/O.
+#include "BlueprintAutoLayoutLog.h"
+#include "Graph/GraphLayoutBenchmark.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// Generated body include.
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BlueprintAutoLayoutBenchmarkCommandlet)
+
+namespace
+{
+// Sizes used when the command line gives none.
+constexpr int32 kDefaultBenchmarkSizes[] = {10, 100, 1000, 5000, 20000};
+
+// Split a '+'-separated command line value into entries.
+TArray<FString> ParseListParam(const TMap<FString, FString> &ParamVals,
+                               const TCHAR *Name)
+{
+    TArray<FString> Values;
+    if (const FString *Found = ParamVals.Find(Name)) {
+        Found->ParseIntoArray(Values, TEXT("+"), true);
+    }
+    return Values;
+}
+
+// Report name of a case: the shape, or the capture file name for replays.
+FString GetCaseName(const GraphLayout::FLayoutBenchmarkResult &Result)
+{
+    return Result.ReplayFile.IsEmpty() ? FString(GraphLayout::LexToString(Result.Shape))
+                                       : FPaths::GetCleanFilename(Result.ReplayFile);
+}
+
+// Golden file key for one benchmark case; replays have no seed.
+FString MakeGoldenKey(const GraphLayout::FLayoutBenchmarkResult &Result, int32 Seed)
+{
+    if (!Result.ReplayFile.IsEmpty()) {
+        return FString::Printf(TEXT("%s,%d,replay"), *GetCaseName(Result),
+                               Result.NodeCount);
+    }
+    return FString::Printf(TEXT("%s,%d,%d"), *GetCaseName(Result), Result.NodeCount,
+                           Seed);
+}
+
+// Read "Shape,Nodes,Seed,Hash" lines; blank lines and '#' comments are skipped.
+bool LoadGoldenHashes(const FString &Filename, TMap<FString, uint64> &OutHashes)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *Filename)) {
+        return false;
+    }
+    for (const FString &RawLine : Lines) {
+        const FString Line = RawLine.TrimStartAndEnd();
+        FString Key;
+        FString Hash;
+        if (Line.IsEmpty() || Line.StartsWith(TEXT("#")) ||
+            !Line.Split(TEXT(","), &Key, &Hash, ESearchCase::CaseSensitive,
+                        ESearchDir::FromEnd)) {
+            continue;
+        }
+        OutHashes.Add(Key, FCString::Strtoui64(*Hash, nullptr, 16));
+    }
+    return true;
+}
+} // namespace
+
+UBlueprintAutoLayoutBenchmarkCommandlet::UBlueprintAutoLayoutBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UBlueprintAutoLayoutBenchmarkCommandlet::Main(const FString &Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    // Map the command line onto benchmark options.
+    GraphLayout::FLayoutBenchmarkOptions Options;
+    for (const FString &ShapeName : ParseListParam(ParamVals, TEXT("Shapes"))) {
+        GraphLayout::ESyntheticGraphShape Shape;
+        if (!GraphLayout::TryParseSyntheticGraphShape(ShapeName, Shape)) {
+            UE_LOG(LogBlueprintAutoLayout, Error,
+                   TEXT("BlueprintAutoLayoutBenchmark: unknown shape '%s'"),
+                   *ShapeName);
+            return 1;
+        }
+        Options.Shapes.Add(Shape);
+    }
+    if (Options.Shapes.IsEmpty()) {
+        for (int32 Value = 0;
+             Value <= static_cast<int32>(GraphLayout::ESyntheticGraphShape::Mixed);
+             ++Value) {
+            Options.Shapes.Add(static_cast<GraphLayout::ESyntheticGraphShape>(Value));
+        }
+    }
+    for (const FString &Size : ParseListParam(ParamVals, TEXT("Sizes"))) {
+        Options.Sizes.Add(FMath::Max(1, FCString::Atoi(*Size)));
+    }
+    if (Options.Sizes.IsEmpty()) {
+        Options.Sizes.Append(kDefaultBenchmarkSizes,
+                             UE_ARRAY_COUNT(kDefaultBenchmarkSizes));
+    }
+    if (const FString *Iterations = ParamVals.Find(TEXT("Iterations"))) {
+        Options.Iterations = FCString::Atoi(**Iterations);
+    }
+    if (const FString *Seed = ParamVals.Find(TEXT("Seed"))) {
+        Options.Seed = FCString::Atoi(**Seed);
+    }
+
+    // Load golden hashes unless this run regenerates them.
+    const FString *GoldenFile = ParamVals.Find(TEXT("Golden"));
+    const bool bWriteGolden = Switches.Contains(TEXT("WriteGolden"));
+    TMap<FString, uint64> GoldenHashes;
+    if (GoldenFile && !bWriteGolden && !LoadGoldenHashes(*GoldenFile, GoldenHashes)) {
+        UE_LOG(LogBlueprintAutoLayout, Error,
+               TEXT("BlueprintAutoLayoutBenchmark: failed to read %s"), **GoldenFile);
+        return 1;
+    }
+
+    // Replay captured production inputs instead of generated graphs when given.
+    const TArray<FString> ReplayFiles = ParseListParam(ParamVals, TEXT("Replay"));
+    TArray<GraphLayout::FLayoutBenchmarkResult> Results;
+    FString Error;
+    bool bSuccess =
+        ReplayFiles.IsEmpty()
+            ? GraphLayout::RunLayoutBenchmarks(Options, Results, &Error)
+            : GraphLayout::RunLayoutReplays(ReplayFiles, Options.Iterations, Results,
+                                            &Error);
+    if (!bSuccess) {
+        UE_LOG(LogBlueprintAutoLayout, Error,
+               TEXT("BlueprintAutoLayoutBenchmark: layout failed: %s"), *Error);
+    }
+
+    // Report each case and check it against the golden hashes.
+    TArray<FString> GoldenLines;
+    for (const GraphLayout::FLayoutBenchmarkResult &Result : Results) {
+        const GraphLayout::FLayoutStats &Stats = Result.Stats;
+        if (!Result.ReplayLabel.IsEmpty()) {
+            UE_LOG(LogBlueprintAutoLayout, Display,
+                   TEXT("BlueprintAutoLayoutBenchmark: %s captured from %s"),
+                   *GetCaseName(Result), *Result.ReplayLabel);
+        }
+        UE_LOG(LogBlueprintAutoLayout, Display,
+               TEXT("BlueprintAutoLayoutBenchmark: shape=%s nodes=%d edges=%d ")
+                   TEXT("components=%d min=%.2fms median=%.2fms extract=%.2f ")
+                   TEXT("cycles=%.2f layers=%.2f tails=%.2f split=%.2f ")
+                   TEXT("crossing=%.2f placement=%.2f dummies=%d sweeps=%d ")
+                   TEXT("crossings=%lld swaps=%d ")
+                   TEXT("mem=+%.1fMB peak=%.1fMB hash=%016llx"),
+               *GetCaseName(Result), Result.NodeCount, Result.EdgeCount,
+               Result.Components, Result.MinMs, Result.MedianMs,
+               Stats.ExtractMs, Stats.RemoveCyclesMs, Stats.AssignLayersMs,
+               Stats.ExecTailsMs, Stats.SplitLongEdgesMs, Stats.CrossingReductionMs,
+               Stats.PlacementMs, Stats.DummyCount, Stats.Sweeps, Stats.Crossings,
+               Stats.TransposeSwaps, Result.UsedPhysicalDeltaBytes / (1024.0 * 1024.0),
+               Result.PeakUsedPhysicalBytes / (1024.0 * 1024.0), Result.OutputHash);
+        if (!Result.bDeterministic) {
+            UE_LOG(LogBlueprintAutoLayout, Error,
+                   TEXT("BlueprintAutoLayoutBenchmark: %s/%d changed between ")
+                       TEXT("iterations"),
+                   *GetCaseName(Result), Result.NodeCount);
+            bSuccess = false;
+        }
+
+        const FString Key = MakeGoldenKey(Result, Options.Seed);
+        GoldenLines.Add(FString::Printf(TEXT("%s,%016llx"), *Key, Result.OutputHash));
+        if (!GoldenFile || bWriteGolden) {
+            continue;
+        }
+        const uint64 *Expected = GoldenHashes.Find(Key);
+        if (!Expected) {
+            UE_LOG(LogBlueprintAutoLayout, Warning,
+                   TEXT("BlueprintAutoLayoutBenchmark: no golden hash for %s"), *Key);
+        } else if (*Expected != Result.OutputHash) {
+            UE_LOG(LogBlueprintAutoLayout, Error,
+                   TEXT("BlueprintAutoLayoutBenchmark: %s hash %016llx, ")
+                       TEXT("golden %016llx"),
+                   *Key, Result.OutputHash, *Expected);
+            bSuccess = false;
+        }
+    }
+
+    // Regenerate the golden file from this run.
+    if (GoldenFile && bWriteGolden) {
+        GoldenLines.Insert(TEXT("# Shape,Nodes,Seed,Hash"), 0);
+        if (!FFileHelper::SaveStringArrayToFile(GoldenLines, **GoldenFile)) {
+            UE_LOG(LogBlueprintAutoLayout, Error,
+                   TEXT("BlueprintAutoLayoutBenchmark: failed to write %s"),
+                   **GoldenFile);
+            return 1;
+        }
+        UE_LOG(LogBlueprintAutoLayout, Display,
+               TEXT("BlueprintAutoLayoutBenchmark: wrote %d hashes to %s"),
+               Results.Num(), **GoldenFile);
+    }
+    return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Commandlet definition.
+#include "BlueprintAutoLayoutCommandlet.h"
+
+// Asset discovery, settings, and batch layout.
+#include "Algo/Unique.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutSettings.h"
+#include "Engine/Blueprint.h"
+#include "K2/K2AutoLayoutBatch.h"
+
+// Generated body include.
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BlueprintAutoLayoutCommandlet)
+
+namespace
+{
+// Split a '+'-separated command line value into entries.
+TArray<FString> ParseListParam(const TMap<FString, FString> &ParamVals,
+                               const TCHAR *Name)
+{
+    TArray<FString> Values;
+    if (const FString *Found = ParamVals.Find(Name)) {
+        Found->ParseIntoArray(Values, TEXT("+"), true);
+    }
+    return Values;
+}
+
+// Resolve package paths and explicit assets into a sorted, unique object list.
+TArray<FSoftObjectPath> GatherBlueprintAssets(const TArray<FString> &PackagePaths,
+                                              const TArray<FString> &AssetNames)
+{
+    TArray<FSoftObjectPath> AssetPaths;
+    for (const FString &AssetName : AssetNames) {
+        AssetPaths.Add(FSoftObjectPath(AssetName));
+    }
+
+    // Scan the requested paths synchronously; commandlets start with an empty cache.
+    if (!PackagePaths.IsEmpty()) {
+        IAssetRegistry &AssetRegistry = IAssetRegistry::GetChecked();
+        AssetRegistry.ScanPathsSynchronous(PackagePaths, true);
+
+        FARFilter Filter;
+        for (const FString &PackagePath : PackagePaths) {
+            Filter.PackagePaths.Add(FName(*PackagePath));
+        }
+        Filter.bRecursivePaths = true;
+        Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+        Filter.bRecursiveClasses = true;
+        TArray<FAssetData> Assets;
+        AssetRegistry.GetAssets(Filter, Assets);
+        for (const FAssetData &Asset : Assets) {
+            AssetPaths.Add(Asset.ToSoftObjectPath());
+        }
+    }
+
+    // Sort so runs over the same content process assets in the same order.
+    AssetPaths.Sort([](const FSoftObjectPath &A, const FSoftObjectPath &B) {
+        return A.ToString() < B.ToString();
+    });
+    AssetPaths.SetNum(Algo::Unique(AssetPaths));
+    return AssetPaths;
+}
+} // namespace
+
+UBlueprintAutoLayoutCommandlet::UBlueprintAutoLayoutCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UBlueprintAutoLayoutCommandlet::Main(const FString &Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    // Collect the assets to process.
+    const TArray<FString> PackagePaths = ParseListParam(ParamVals, TEXT("Paths"));
+    const TArray<FString> AssetNames = ParseListParam(ParamVals, TEXT("Assets"));
+    if (PackagePaths.IsEmpty() && AssetNames.IsEmpty()) {
+        UE_LOG(LogBlueprintAutoLayout, Error,
+               TEXT("BlueprintAutoLayout: pass -Paths=<path>[+<path>] or ")
+                   TEXT("-Assets=<object>[+<object>]."));
+        return 1;
+    }
+    const TArray<FSoftObjectPath> AssetPaths =
+        GatherBlueprintAssets(PackagePaths, AssetNames);
+
+    // Map the command line onto batch options.
+    K2AutoLayout::FBatchAutoLayoutOptions Options;
+    Options.bSave = !Switches.Contains(TEXT("NoSave"));
+    if (const FString *MaxInFlight = ParamVals.Find(TEXT("MaxInFlight"))) {
+        Options.MaxAssetsInFlight = FCString::Atoi(**MaxInFlight);
+    }
+
+    // Lay out with the project's editor settings.
+    const K2AutoLayout::FAutoLayoutSettings Settings =
+        GetDefault<UBlueprintAutoLayoutSettings>()->ToAutoLayoutSettings();
+    K2AutoLayout::FBatchAutoLayoutResult Result;
+    UE_LOG(LogBlueprintAutoLayout, Display,
+           TEXT("BlueprintAutoLayout: processing %d assets (save=%d inFlight=%d)"),
+           AssetPaths.Num(), Options.bSave ? 1 : 0, Options.MaxAssetsInFlight);
+    const bool bSuccess =
+        K2AutoLayout::AutoLayoutBlueprintAssets(AssetPaths, Settings, Options, Result);
+
+    // Summarize the run for CI logs.
+    UE_LOG(LogBlueprintAutoLayout, Display,
+           TEXT("BlueprintAutoLayout: assets=%d saved=%d graphs=%d skipped=%d ")
+               TEXT("nodes=%d errors=%d"),
+           Result.AssetsProcessed, Result.AssetsSaved, Result.GraphsLaidOut,
+           Result.GraphsSkipped, Result.NodesLaidOut, Result.Errors.Num());
+    return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Function library definition.
+#include "BlueprintAutoLayoutLibrary.h"
+
+// Settings and batch layout.
+#include "BlueprintAutoLayoutSettings.h"
+#include "K2/K2AutoLayoutBatch.h"
+
+// Generated body include.
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BlueprintAutoLayoutLibrary)
+
+bool UBlueprintAutoLayoutLibrary::AutoLayoutBlueprint(UBlueprint *Blueprint,
+                                                      int32 &NodesLaidOut,
+                                                      FString &Error)
+{
+    const K2AutoLayout::FAutoLayoutSettings Settings =
+        GetDefault<UBlueprintAutoLayoutSettings>()->ToAutoLayoutSettings();
+    K2AutoLayout::FBatchAutoLayoutResult Result;
+    const bool bSuccess =
+        K2AutoLayout::AutoLayoutBlueprintGraphs(Blueprint, Settings, Result);
+    NodesLaidOut = Result.NodesLaidOut;
+    Error = FString::Join(Result.Errors, TEXT("\n"));
+    return bSuccess;
+}
+
+bool UBlueprintAutoLayoutLibrary::AutoLayoutBlueprintAssets(
+    const TArray<FSoftObjectPath> &Assets, bool bSave, int32 &NodesLaidOut,
+    FString &Error)
+{
+    const K2AutoLayout::FAutoLayoutSettings Settings =
+        GetDefault<UBlueprintAutoLayoutSettings>()->ToAutoLayoutSettings();
+    K2AutoLayout::FBatchAutoLayoutOptions Options;
+    Options.bSave = bSave;
+    K2AutoLayout::FBatchAutoLayoutResult Result;
+    const bool bSuccess =
+        K2AutoLayout::AutoLayoutBlueprintAssets(Assets, Settings, Options, Result);
+    NodesLaidOut = Result.NodesLaidOut;
+    Error = FString::Join(Result.Errors, TEXT("\n"));
+    return bSuccess;
+}
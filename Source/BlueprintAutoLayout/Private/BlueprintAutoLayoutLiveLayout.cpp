@@ -0,0 +1,378 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Live layout interface.
+#include "BlueprintAutoLayoutLiveLayout.h"
+
+// Editor dependencies for edit tracking, ticking, and layout.
+#include "Async/Async.h"
+#include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutSettings.h"
+#include "Containers/Ticker.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "GraphEditor.h"
+#include "K2/K2AutoLayout.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+// Live layout implementation.
+namespace BlueprintAutoLayout
+{
+namespace
+{
+// Seconds between scans for newly opened Blueprint editors.
+constexpr double kOpenEditorScanIntervalSeconds = 1.0;
+
+// Edit tracking for one graph of an open Blueprint.
+struct FLiveGraphState
+{
+    TWeakObjectPtr<UBlueprint> Blueprint;
+    TWeakObjectPtr<UEdGraph> Graph;
+
+    // Link hash of every node as of the last diff; new or changed hashes seed layout.
+    TMap<FGuid, uint32> LinkHashes;
+
+    // Nodes found edited but not yet laid out; kept when a run is discarded.
+    TSet<FGuid> PendingSeeds;
+
+    // Bumped on every edit so runs started at an older revision are discarded.
+    uint32 Revision = 0;
+    double LastEditSeconds = 0.0;
+    bool bEditPending = false;
+};
+
+// Layout computed a few components per frame from the ticker.
+struct FLiveLayoutRun
+{
+    FObjectKey GraphKey;
+    uint32 Revision = 0;
+    TSharedRef<K2AutoLayout::FAutoLayoutJob> Job =
+        MakeShared<K2AutoLayout::FAutoLayoutJob>();
+    int32 NextComponent = 0;
+
+    // Set when an island is too large for the frame budget: the whole job then
+    // computes on the thread pool and the ticker only polls it. The task shares the
+    // job, so a discarded run does not wait for it on the game thread.
+    TSharedPtr<K2AutoLayout::FAutoLayoutProgress> Progress;
+    TFuture<void> Task;
+};
+
+// Tracked graphs, the run in flight, and the editor hooks that feed them.
+TMap<FObjectKey, FLiveGraphState> GLiveGraphs;
+TUniquePtr<FLiveLayoutRun> GLiveRun;
+TArray<TFuture<void>> GDiscardedLiveTasks;
+double GLastOpenEditorScanSeconds = 0.0;
+FTSTicker::FDelegateHandle GLiveLayoutTickerHandle;
+FDelegateHandle GObjectPropertyChangedHandle;
+FDelegateHandle GPostUndoRedoHandle;
+
+// Hash the links of a node, ignoring its position so moves never trigger layout.
+uint32 ComputeNodeLinkHash(const UEdGraphNode *Node)
+{
+    uint32 Hash = 0;
+    for (const UEdGraphPin *Pin : Node->Pins) {
+        if (!Pin) {
+            continue;
+        }
+        for (const UEdGraphPin *Linked : Pin->LinkedTo) {
+            const UEdGraphNode *LinkedNode =
+                Linked ? Linked->GetOwningNodeUnchecked() : nullptr;
+            if (!LinkedNode) {
+                continue;
+            }
+            Hash = HashCombine(Hash, GetTypeHash(Pin->PinName));
+            Hash = HashCombine(Hash, GetTypeHash(LinkedNode->NodeGuid));
+            Hash = HashCombine(Hash, GetTypeHash(Linked->PinName));
+        }
+    }
+    return Hash;
+}
+
+// Replace the recorded link hashes, adding new and relinked nodes to OutSeeds.
+void DiffLinkHashes(const UEdGraph &Graph, TMap<FGuid, uint32> &InOutLinkHashes,
+                    TSet<FGuid> *OutSeeds)
+{
+    TMap<FGuid, uint32> Current;
+    Current.Reserve(Graph.Nodes.Num());
+    for (const UEdGraphNode *Node : Graph.Nodes) {
+        if (!Node || !Node->NodeGuid.IsValid()) {
+            continue;
+        }
+        const uint32 Hash = ComputeNodeLinkHash(Node);
+        Current.Add(Node->NodeGuid, Hash);
+        if (OutSeeds) {
+            const uint32 *Previous = InOutLinkHashes.Find(Node->NodeGuid);
+            if (!Previous || *Previous != Hash) {
+                OutSeeds->Add(Node->NodeGuid);
+            }
+        }
+    }
+    InOutLinkHashes = MoveTemp(Current);
+}
+
+// Drop the run in flight, canceling its background compute if it has one. The
+// canceled task is kept until it finishes so shutdown can wait for it.
+void DiscardLiveRun()
+{
+    if (GLiveRun.IsValid() && GLiveRun->Progress.IsValid()) {
+        GLiveRun->Progress->bCancelRequested = true;
+        if (GLiveRun->Task.IsValid() && !GLiveRun->Task.IsReady()) {
+            GDiscardedLiveTasks.Add(MoveTemp(GLiveRun->Task));
+        }
+    }
+    GLiveRun.Reset();
+    GDiscardedLiveTasks.RemoveAll(
+        [](const TFuture<void> &Task) { return Task.IsReady(); });
+}
+
+// Drop every tracked graph and any run in flight, waiting for canceled tasks.
+void ResetLiveLayout()
+{
+    DiscardLiveRun();
+    for (TFuture<void> &Task : GDiscardedLiveTasks) {
+        Task.Wait();
+    }
+    GDiscardedLiveTasks.Reset();
+    GLiveGraphs.Reset();
+}
+
+// Start tracking the graphs of Blueprints opened since the last scan, so the
+// first edit after opening is already diffed against a baseline.
+void ScanOpenBlueprintEditors(double NowSeconds)
+{
+    if (NowSeconds - GLastOpenEditorScanSeconds < kOpenEditorScanIntervalSeconds) {
+        return;
+    }
+    GLastOpenEditorScanSeconds = NowSeconds;
+
+    // Forget graphs that were deleted or whose editor was closed.
+    for (auto It = GLiveGraphs.CreateIterator(); It; ++It) {
+        if (!It.Value().Graph.IsValid() || !It.Value().Blueprint.IsValid()) {
+            It.RemoveCurrent();
+        }
+    }
+
+    UAssetEditorSubsystem *AssetEditorSubsystem =
+        GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+    if (!AssetEditorSubsystem) {
+        return;
+    }
+    TArray<UEdGraph *> Graphs;
+    for (UObject *Asset : AssetEditorSubsystem->GetAllEditedAssets()) {
+        UBlueprint *Blueprint = Cast<UBlueprint>(Asset);
+        if (!Blueprint) {
+            continue;
+        }
+        Graphs.Reset();
+        FBlueprintEditorUtils::GetAllGraphs(Blueprint, Graphs);
+        for (UEdGraph *Graph : Graphs) {
+            if (!Graph || GLiveGraphs.Contains(FObjectKey(Graph))) {
+                continue;
+            }
+            FLiveGraphState &State = GLiveGraphs.Add(FObjectKey(Graph));
+            State.Blueprint = Blueprint;
+            State.Graph = Graph;
+            DiffLinkHashes(*Graph, State.LinkHashes, nullptr);
+        }
+    }
+}
+
+// Blueprint edits (paste, spawn, relink) end in MarkBlueprintAsModified, which
+// reports a property change on the Blueprint; node drags do not.
+void HandleObjectPropertyChanged(UObject *Object, FPropertyChangedEvent &Event)
+{
+    UBlueprint *Blueprint = Cast<UBlueprint>(Object);
+    if (!Blueprint || GLiveGraphs.IsEmpty()) {
+        return;
+    }
+
+    // Mark every tracked graph of the Blueprint; the diff finds the edited ones.
+    const double NowSeconds = FPlatformTime::Seconds();
+    for (TPair<FObjectKey, FLiveGraphState> &Pair : GLiveGraphs) {
+        FLiveGraphState &State = Pair.Value;
+        if (State.Blueprint.Get() != Blueprint) {
+            continue;
+        }
+        ++State.Revision;
+        State.LastEditSeconds = NowSeconds;
+        State.bEditPending = true;
+    }
+}
+
+// Undo and redo restore a state the user already saw; take it as the new baseline
+// instead of laying it out, which would also clear the redo history.
+void HandlePostUndoRedo()
+{
+    DiscardLiveRun();
+    for (TPair<FObjectKey, FLiveGraphState> &Pair : GLiveGraphs) {
+        FLiveGraphState &State = Pair.Value;
+        ++State.Revision;
+        State.bEditPending = false;
+        State.PendingSeeds.Reset();
+        if (const UEdGraph *Graph = State.Graph.Get()) {
+            DiffLinkHashes(*Graph, State.LinkHashes, nullptr);
+        }
+    }
+}
+
+// Capture a job for the islands around the graph's edited nodes.
+void StartLiveLayout(const FObjectKey &GraphKey, FLiveGraphState &State,
+                     const UBlueprintAutoLayoutSettings &Settings)
+{
+    UBlueprint *Blueprint = State.Blueprint.Get();
+    UEdGraph *Graph = State.Graph.Get();
+    if (!Blueprint || !Graph) {
+        return;
+    }
+
+    // Collect the edited nodes, including seeds left over from a discarded run.
+    DiffLinkHashes(*Graph, State.LinkHashes, &State.PendingSeeds);
+    if (State.PendingSeeds.IsEmpty()) {
+        return;
+    }
+
+    // Only lay out graphs the user is looking at; keep the seeds for later.
+    if (!SGraphEditor::FindGraphEditorForGraph(Graph).IsValid()) {
+        return;
+    }
+    TArray<UEdGraphNode *> Seeds;
+    Seeds.Reserve(State.PendingSeeds.Num());
+    for (UEdGraphNode *Node : Graph->Nodes) {
+        if (Node && State.PendingSeeds.Contains(Node->NodeGuid)) {
+            Seeds.Add(Node);
+        }
+    }
+
+    // Preparation reads widget geometry and runs whole on this frame. The graph is
+    // already shown, so its panel is reused without bringing its tab to front.
+    TUniquePtr<FLiveLayoutRun> Run = MakeUnique<FLiveLayoutRun>();
+    Run->GraphKey = GraphKey;
+    Run->Revision = State.Revision;
+    K2AutoLayout::FAutoLayoutResult Result;
+    if (!K2AutoLayout::PrepareAutoLayout(
+            Blueprint, Graph, Seeds, Settings.ToAutoLayoutSettings(), *Run->Job,
+            Result, K2AutoLayout::EAutoLayoutPanelMode::ExistingOnly)) {
+        UE_LOG(LogBlueprintAutoLayout, Verbose, TEXT("LiveLayout: skipped %s: %s"),
+               *Graph->GetName(), *Result.Error);
+        State.PendingSeeds.Reset();
+        return;
+    }
+
+    // Islands are never split across frames, so one large island would stall the
+    // frame; such jobs compute in the background and commit through the checksum.
+    int32 LargestComponent = 0;
+    for (const TArray<int32> &Component : Run->Job->Components) {
+        LargestComponent = FMath::Max(LargestComponent, Component.Num());
+    }
+    if (LargestComponent >= Settings.LiveLayoutBackgroundMinNodes) {
+        Run->Progress = MakeShared<K2AutoLayout::FAutoLayoutProgress>();
+        Run->Task = Async(EAsyncExecution::ThreadPool,
+                          [Job = Run->Job, Progress = Run->Progress]() {
+                              K2AutoLayout::ComputeAutoLayout(*Job, Progress.Get());
+                          });
+    }
+    GLiveRun = MoveTemp(Run);
+}
+
+// Advance the run in flight within the frame budget and commit it when done.
+void ContinueLiveLayout(const UBlueprintAutoLayoutSettings &Settings)
+{
+    FLiveGraphState *State = GLiveGraphs.Find(GLiveRun->GraphKey);
+    if (!State || State->Revision != GLiveRun->Revision) {
+        UE_LOG(LogBlueprintAutoLayout, Verbose,
+               TEXT("LiveLayout: discarded a run for an edited graph"));
+        DiscardLiveRun();
+        return;
+    }
+
+    // Background runs are only polled; inline runs spend the frame budget.
+    if (GLiveRun->Progress.IsValid()) {
+        if (!GLiveRun->Task.IsReady()) {
+            return;
+        }
+    } else {
+        const double BudgetSeconds =
+            FMath::Max(0.0, static_cast<double>(Settings.LiveLayoutFrameBudgetMs)) /
+            1000.0;
+        if (!K2AutoLayout::ComputeAutoLayoutSlice(
+                *GLiveRun->Job, GLiveRun->NextComponent, BudgetSeconds)) {
+            return;
+        }
+    }
+
+    // Seeds are consumed whether or not the commit applies.
+    K2AutoLayout::FAutoLayoutResult Result;
+    if (K2AutoLayout::CommitAutoLayout(*GLiveRun->Job, Result)) {
+        UE_LOG(LogBlueprintAutoLayout, Verbose,
+               TEXT("LiveLayout: laid out %d nodes, %d moved"), Result.NodesLaidOut,
+               Result.NodesMoved);
+    } else {
+        UE_LOG(LogBlueprintAutoLayout, Verbose, TEXT("LiveLayout: commit failed: %s"),
+               *Result.Error);
+    }
+    State->PendingSeeds.Reset();
+    GLiveRun.Reset();
+}
+
+// Editor ticker: resume the run in flight or start one for a settled graph.
+bool TickLiveLayout(float DeltaTime)
+{
+    const UBlueprintAutoLayoutSettings *Settings =
+        GetDefault<UBlueprintAutoLayoutSettings>();
+    if (!Settings || !Settings->bLiveLayout) {
+        if (GLiveRun.IsValid() || !GLiveGraphs.IsEmpty()) {
+            ResetLiveLayout();
+        }
+        return true;
+    }
+
+    const double NowSeconds = FPlatformTime::Seconds();
+    ScanOpenBlueprintEditors(NowSeconds);
+    if (GLiveRun.IsValid()) {
+        ContinueLiveLayout(*Settings);
+        return true;
+    }
+
+    // Start with the first graph whose edits have been quiet for the debounce time.
+    const double DebounceSeconds = Settings->LiveLayoutDebounceSeconds;
+    for (TPair<FObjectKey, FLiveGraphState> &Pair : GLiveGraphs) {
+        FLiveGraphState &State = Pair.Value;
+        if (!State.bEditPending ||
+            NowSeconds - State.LastEditSeconds < DebounceSeconds) {
+            continue;
+        }
+        State.bEditPending = false;
+        StartLiveLayout(Pair.Key, State, *Settings);
+        if (GLiveRun.IsValid()) {
+            break;
+        }
+    }
+    return true;
+}
+} // namespace
+
+// Register the edit hooks and the ticker.
+void StartupLiveLayout()
+{
+    GObjectPropertyChangedHandle =
+        FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(
+            &HandleObjectPropertyChanged);
+    GPostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddStatic(&HandlePostUndoRedo);
+    GLiveLayoutTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateStatic(&TickLiveLayout));
+}
+
+// Remove the hooks and drop all tracked state.
+void ShutdownLiveLayout()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(GLiveLayoutTickerHandle);
+    FEditorDelegates::PostUndoRedo.Remove(GPostUndoRedoHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(GObjectPropertyChangedHandle);
+    ResetLiveLayout();
+}
+} // namespace BlueprintAutoLayout
@@ -4,22 +4,28 @@
 #include "Modules/ModuleManager.h"
 
 // Plugin and editor dependencies for auto layout UI.
+#include "Async/Async.h"
+#include "BlueprintAutoLayoutLiveLayout.h"
 #include "BlueprintAutoLayoutLog.h"
 #include "BlueprintAutoLayoutSettings.h"
+#include "BlueprintAutoLayoutStats.h"
+#include "BlueprintAutoLayoutTrace.h"
 #include "BlueprintEditor.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Engine/Blueprint.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "Graph/GraphLayoutResultCache.h"
 #include "GraphEditor.h"
 #include "K2/K2AutoLayout.h"
 #include "K2/K2AutoLayoutComplexity.h"
+#include "K2/K2NodeSizeCache.h"
 #include "K2Node_Knot.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #if !UE_BUILD_SHIPPING && !UE_BUILD_TEST
-#include "SGraphNode.h"
+#include "K2/K2NodeGeometrySnapshot.h"
 #include "SGraphPanel.h"
 #endif
 #include "ToolMenus.h"
@@ -29,6 +35,22 @@
 // Define the log category used by the plugin.
 DEFINE_LOG_CATEGORY(LogBlueprintAutoLayout);
 
+// Stats shown by `stat BlueprintAutoLayout`.
+DEFINE_STAT(STAT_BlueprintAutoLayout_Prepare);
+DEFINE_STAT(STAT_BlueprintAutoLayout_Compute);
+DEFINE_STAT(STAT_BlueprintAutoLayout_Commit);
+DEFINE_STAT(STAT_BlueprintAutoLayout_LayoutComponent);
+DEFINE_STAT(STAT_BlueprintAutoLayout_RemoveCycles);
+DEFINE_STAT(STAT_BlueprintAutoLayout_AssignLayers);
+DEFINE_STAT(STAT_BlueprintAutoLayout_ExecTails);
+DEFINE_STAT(STAT_BlueprintAutoLayout_SplitLongEdges);
+DEFINE_STAT(STAT_BlueprintAutoLayout_CrossingReduction);
+DEFINE_STAT(STAT_BlueprintAutoLayout_Placement);
+DEFINE_STAT(STAT_BlueprintAutoLayout_CoarsenExecLanes);
+DEFINE_STAT(STAT_BlueprintAutoLayout_Nodes);
+DEFINE_STAT(STAT_BlueprintAutoLayout_Dummies);
+DEFINE_STAT(STAT_BlueprintAutoLayout_Sweeps);
+
 // Text namespace for localized UI strings.
 #define LOCTEXT_NAMESPACE "BlueprintAutoLayout"
 
@@ -126,29 +148,22 @@ bool TryGetNodeWidgetSizes(const UEdGraphNode *Node, const UEdGraph *Graph,
         return false;
     }
 
-    // Resolve Blueprint editor state and graph editors for the target graph.
-    const TSharedPtr<SGraphEditor> GraphEditor =
-        SGraphEditor::FindGraphEditorForGraph(Graph);
-    const UBlueprint *Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
-    const TSharedPtr<IBlueprintEditor> BlueprintEditor =
-        Blueprint
-            ? FKismetEditorUtilities::GetIBlueprintEditorForObject(Blueprint, false)
-            : nullptr;
-    const UEdGraph *FocusedGraph =
-        BlueprintEditor.IsValid() ? BlueprintEditor->GetFocusedGraph() : nullptr;
-    const TSharedPtr<SGraphEditor> GraphEditorFromOpen =
-        BlueprintEditor.IsValid() ? BlueprintEditor->OpenGraphAndBringToFront(
-                                        const_cast<UEdGraph *>(Graph), false)
-                                  : nullptr;
-    UE_LOG(LogBlueprintAutoLayout, Verbose,
-           TEXT("TryGetNodeWidgetSizes: GraphEditor find=%p open=%p blueprintEditor=%p "
-                "focusedGraph=%s blueprint=%s"),
-           GraphEditor.Get(), GraphEditorFromOpen.Get(), BlueprintEditor.Get(),
-           FocusedGraph ? *FocusedGraph->GetName() : TEXT("null"),
-           Blueprint ? *Blueprint->GetName() : TEXT("null"));
-    const TSharedPtr<SGraphEditor> ActiveGraphEditor =
-        GraphEditorFromOpen.IsValid() ? GraphEditorFromOpen : GraphEditor;
-    if (!ActiveGraphEditor.IsValid()) {
+    // The context menu comes from an open graph, so look for its editor first and
+    // only ask the Blueprint editor to open the graph when none is found.
+    TSharedPtr<SGraphEditor> GraphEditor = SGraphEditor::FindGraphEditorForGraph(Graph);
+    if (!GraphEditor.IsValid()) {
+        const UBlueprint *Blueprint =
+            FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+        const TSharedPtr<IBlueprintEditor> BlueprintEditor =
+            Blueprint
+                ? FKismetEditorUtilities::GetIBlueprintEditorForObject(Blueprint, false)
+                : nullptr;
+        if (BlueprintEditor.IsValid()) {
+            GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(
+                const_cast<UEdGraph *>(Graph), false);
+        }
+    }
+    if (!GraphEditor.IsValid()) {
         UE_LOG(LogBlueprintAutoLayout, Verbose,
                TEXT("TryGetNodeWidgetSizes: no graph editor for graph %s"),
                *Graph->GetName());
@@ -156,7 +171,7 @@ bool TryGetNodeWidgetSizes(const UEdGraphNode *Node, const UEdGraph *Graph,
     }
 
     // Fetch the graph panel to access node widgets.
-    SGraphPanel *GraphPanel = ActiveGraphEditor->GetGraphPanel();
+    SGraphPanel *GraphPanel = GraphEditor->GetGraphPanel();
     if (!GraphPanel) {
         UE_LOG(LogBlueprintAutoLayout, Verbose,
                TEXT("TryGetNodeWidgetSizes: graph panel missing for graph %s"),
@@ -164,10 +179,13 @@ bool TryGetNodeWidgetSizes(const UEdGraphNode *Node, const UEdGraph *Graph,
         return false;
     }
 
-    // Resolve the node widget by GUID to capture geometry.
-    const TSharedPtr<SGraphNode> NodeWidget =
-        GraphPanel->GetNodeWidgetFromGuid(Node->NodeGuid);
-    if (!NodeWidget.IsValid()) {
+    // Read the node from the same panel snapshot the layout uses.
+    const TSet<UEdGraphNode *> Nodes = {const_cast<UEdGraphNode *>(Node)};
+    K2AutoLayout::FNodeGeometrySnapshot Geometry;
+    K2AutoLayout::CaptureNodeGeometry(*GraphPanel, Nodes, Geometry);
+    const K2AutoLayout::FNodeGeometrySnapshot::FNode *NodeGeometry =
+        Geometry.Find(Node);
+    if (!NodeGeometry) {
         UE_LOG(LogBlueprintAutoLayout, Verbose,
                TEXT("TryGetNodeWidgetSizes: node widget not found for %s in graph %s"),
                *Node->GetName(), *Graph->GetName());
@@ -199,9 +217,9 @@ bool TryGetNodeWidgetSizes(const UEdGraphNode *Node, const UEdGraph *Graph,
         return false;
     }
 
-    // Capture size data from the widget geometry.
-    OutAbsoluteSize = NodeWidget->GetCachedGeometry().GetAbsoluteSize();
-    OutDesiredSize = NodeWidget->GetDesiredSize();
+    // Report the captured widget sizes.
+    OutAbsoluteSize = FVector2D(NodeGeometry->AbsoluteSize);
+    OutDesiredSize = FVector2D(NodeGeometry->DesiredSize);
     UE_LOG(LogBlueprintAutoLayout, Verbose,
            TEXT("TryGetNodeWidgetSizes: %s abs=(%.1f, %.1f) desired=(%.1f, %.1f)"),
            *Node->GetName(), OutAbsoluteSize.X, OutAbsoluteSize.Y, OutDesiredSize.X,
@@ -227,6 +245,152 @@ void ShowAutoLayoutNotification(const FString &Message, bool bSuccess)
     }
 }
 
+// Build the failure message shown for an auto layout result.
+FString BuildFailureMessage(const K2AutoLayout::FAutoLayoutResult &Result)
+{
+    // Surface detailed error guidance when available.
+    FString Message = Result.Error;
+    if (!Result.Guidance.IsEmpty()) {
+        Message += TEXT("\n") + Result.Guidance;
+    }
+    if (Message.IsEmpty()) {
+        Message = TEXT("Auto layout failed.");
+    }
+    return Message;
+}
+
+// Build the success message shown for an applied auto layout.
+FString BuildSuccessMessage(const K2AutoLayout::FAutoLayoutResult &Result)
+{
+    if (Result.NodesMoved == 0) {
+        return FString::Printf(TEXT("Auto layout: already laid out (%d nodes)."),
+                               Result.NodesLaidOut);
+    }
+    return FString::Printf(TEXT("Auto layout applied (%d nodes, %d moved)."),
+                           Result.NodesLaidOut, Result.NodesMoved);
+}
+
+// Background layout in flight; the compute task and its notification share it.
+struct FBackgroundAutoLayout
+{
+    TSharedPtr<K2AutoLayout::FAutoLayoutJob> Job;
+    K2AutoLayout::FAutoLayoutProgress Progress;
+    TSharedPtr<SNotificationItem> Notification;
+    TFuture<void> Task;
+
+    // Set on module shutdown; an already queued commit then does nothing.
+    bool bShutDown = false;
+};
+
+// Only one background layout runs at a time so commits never interleave.
+TSharedPtr<FBackgroundAutoLayout> GActiveBackgroundLayout;
+
+// Game thread: commit or discard a finished background layout and report it.
+void FinishBackgroundAutoLayout(const TSharedRef<FBackgroundAutoLayout> &State)
+{
+    if (GActiveBackgroundLayout == State) {
+        GActiveBackgroundLayout.Reset();
+    }
+
+    // Canceled jobs are dropped; stale jobs are rejected inside the commit.
+    K2AutoLayout::FAutoLayoutResult Result;
+    bool bSuccess = false;
+    FString Message;
+    if (State->Progress.bCancelRequested.load()) {
+        Message = TEXT("Auto layout canceled.");
+    } else if (K2AutoLayout::CommitAutoLayout(*State->Job, Result)) {
+        bSuccess = true;
+        Message = BuildSuccessMessage(Result);
+    } else {
+        Message = BuildFailureMessage(Result);
+    }
+
+    // Turn the progress notification into the result notification.
+    if (!State->Notification.IsValid()) {
+        ShowAutoLayoutNotification(Message, bSuccess);
+        return;
+    }
+    State->Notification->SetText(FText::FromString(Message));
+    State->Notification->SetCompletionState(bSuccess ? SNotificationItem::CS_Success
+                                                     : SNotificationItem::CS_Fail);
+    State->Notification->ExpireAndFadeout();
+}
+
+// Compute a prepared job on the thread pool behind a cancelable notification.
+void StartBackgroundAutoLayout(const TSharedRef<K2AutoLayout::FAutoLayoutJob> &Job)
+{
+    const TSharedRef<FBackgroundAutoLayout> State = MakeShared<FBackgroundAutoLayout>();
+    State->Job = Job;
+    const TWeakPtr<FBackgroundAutoLayout> WeakState = State;
+    const int32 NodeCount = Job->LayoutGraph.Nodes.Num();
+    const int32 ComponentCount = Job->Components.Num();
+
+    // The progress text reads the shared counters whenever the notification paints.
+    FNotificationInfo Info(FText::GetEmpty());
+    Info.Text = TAttribute<FText>::CreateLambda([WeakState, NodeCount,
+                                                 ComponentCount]() {
+        const TSharedPtr<FBackgroundAutoLayout> Pinned = WeakState.Pin();
+        if (Pinned && Pinned->Progress.bCancelRequested.load()) {
+            return LOCTEXT("BackgroundLayoutCanceling", "Canceling auto layout...");
+        }
+        const int32 Completed =
+            Pinned ? Pinned->Progress.CompletedComponents.load() : ComponentCount;
+        return FText::Format(LOCTEXT("BackgroundLayoutProgress",
+                                     "Auto layout running ({0} nodes, {1}/{2} "
+                                     "islands)..."),
+                             FText::AsNumber(NodeCount), FText::AsNumber(Completed),
+                             FText::AsNumber(ComponentCount));
+    });
+    Info.bFireAndForget = false;
+    Info.bUseThrobber = true;
+    Info.bUseSuccessFailIcons = true;
+    Info.ExpireDuration = 3.0f;
+    Info.FadeOutDuration = 0.3f;
+    Info.ButtonDetails.Add(FNotificationButtonInfo(
+        LOCTEXT("BackgroundLayoutCancel", "Cancel"),
+        LOCTEXT("BackgroundLayoutCancelTooltip", "Cancel the running auto layout."),
+        FSimpleDelegate::CreateLambda([WeakState]() {
+            if (const TSharedPtr<FBackgroundAutoLayout> Pinned = WeakState.Pin()) {
+                Pinned->Progress.bCancelRequested = true;
+            }
+        }),
+        SNotificationItem::CS_Pending));
+    State->Notification = FSlateNotificationManager::Get().AddNotification(Info);
+    if (State->Notification.IsValid()) {
+        State->Notification->SetCompletionState(SNotificationItem::CS_Pending);
+    }
+
+    // Compute off the game thread, then hop back to commit. The game thread task
+    // only holds the state weakly and checks for shutdown, because it can still be
+    // queued after ShutdownModule released the layout.
+    GActiveBackgroundLayout = State;
+    State->Task = Async(EAsyncExecution::ThreadPool, [State, WeakState]() {
+        K2AutoLayout::ComputeAutoLayout(*State->Job, &State->Progress);
+        AsyncTask(ENamedThreads::GameThread, [WeakState]() {
+            const TSharedPtr<FBackgroundAutoLayout> Pinned = WeakState.Pin();
+            if (Pinned.IsValid() && !Pinned->bShutDown) {
+                FinishBackgroundAutoLayout(Pinned.ToSharedRef());
+            }
+        });
+    });
+}
+
+// Cancel the background layout in flight for shutdown and wait for its compute
+// task; its commit, if already queued, is skipped.
+void CancelBackgroundAutoLayout()
+{
+    const TSharedPtr<FBackgroundAutoLayout> State = GActiveBackgroundLayout;
+    if (!State.IsValid()) {
+        return;
+    }
+    State->bShutDown = true;
+    State->Progress.bCancelRequested = true;
+    if (State->Task.IsValid()) {
+        State->Task.Wait();
+    }
+    GActiveBackgroundLayout.Reset();
+}
+
 // Execute auto layout for the selected nodes in the context menu.
 void HandleAutoLayoutSelectedNodes(const FToolMenuContext &InContext)
 {
@@ -275,29 +439,44 @@ void HandleAutoLayoutSelectedNodes(const FToolMenuContext &InContext)
         }
     }
 
-    // Pull editor-configured settings and attempt the auto layout.
+    // Reject a second run while a background layout is still in flight.
+    if (GActiveBackgroundLayout.IsValid()) {
+        ShowAutoLayoutNotification(TEXT("Auto layout is already running."), false);
+        return;
+    }
+
+    // Pull editor-configured settings and capture the layout input here; widget
+    // sizes can only be read on the game thread.
+    const UBlueprintAutoLayoutSettings *EditorSettings =
+        GetDefault<UBlueprintAutoLayoutSettings>();
     const K2AutoLayout::FAutoLayoutSettings Settings =
-        GetDefault<UBlueprintAutoLayoutSettings>()->ToAutoLayoutSettings();
+        EditorSettings->ToAutoLayoutSettings();
+    const TSharedRef<K2AutoLayout::FAutoLayoutJob> Job =
+        MakeShared<K2AutoLayout::FAutoLayoutJob>();
     K2AutoLayout::FAutoLayoutResult Result;
-    if (!K2AutoLayout::AutoLayoutIslands(const_cast<UBlueprint *>(Blueprint),
+    if (!K2AutoLayout::PrepareAutoLayout(const_cast<UBlueprint *>(Blueprint),
                                          const_cast<UEdGraph *>(Graph), MutableNodes,
-                                         Settings, Result)) {
-        // Surface detailed error guidance when available.
-        FString Message = Result.Error;
-        if (!Result.Guidance.IsEmpty()) {
-            Message += TEXT("\n") + Result.Guidance;
-        }
-        if (Message.IsEmpty()) {
-            Message = TEXT("Auto layout failed.");
-        }
-        ShowAutoLayoutNotification(Message, false);
+                                         Settings, *Job, Result)) {
+        ShowAutoLayoutNotification(BuildFailureMessage(Result), false);
+        return;
+    }
+
+    // Large islands compute in the background so the editor stays responsive.
+    if (EditorSettings->bBackgroundLayout &&
+        Job->LayoutGraph.Nodes.Num() >= EditorSettings->BackgroundLayoutMinNodes) {
+        StartBackgroundAutoLayout(Job);
+        return;
+    }
+
+    // Small islands compute and commit immediately.
+    K2AutoLayout::ComputeAutoLayout(*Job);
+    if (!K2AutoLayout::CommitAutoLayout(*Job, Result)) {
+        ShowAutoLayoutNotification(BuildFailureMessage(Result), false);
         return;
     }
 
     // Report the successful application with a node count.
-    const FString Message =
-        FString::Printf(TEXT("Auto layout applied (%d nodes)."), Result.NodesLaidOut);
-    ShowAutoLayoutNotification(Message, true);
+    ShowAutoLayoutNotification(BuildSuccessMessage(Result), true);
 }
 
 // Determine whether the Auto Layout entry should be visible.
@@ -328,6 +507,18 @@ class FBlueprintAutoLayoutModule : public IModuleInterface
   public:
     virtual void StartupModule() override
     {
+        // Restore persisted node size estimates for cold-start layouts.
+        K2AutoLayout::StartupNodeSizeCache();
+
+        // Keep complexity indices in sync with Blueprint edits.
+        K2AutoLayout::StartupComplexityIndex();
+
+        // Follow graph edits for the optional live layout mode.
+        BlueprintAutoLayout::StartupLiveLayout();
+
+        // Prime the cached trace verbosity from the log category.
+        BlueprintAutoLayout::RefreshTraceVerbosity();
+
         // Register menu extensions when tool menus are ready.
         UToolMenus::RegisterStartupCallback(
             FSimpleMulticastDelegate::FDelegate::CreateRaw(
@@ -340,6 +531,19 @@ class FBlueprintAutoLayoutModule : public IModuleInterface
         // Unregister menu hooks owned by this module.
         UToolMenus::UnRegisterStartupCallback(this);
         UToolMenus::UnregisterOwner(this);
+
+        // Drop any background or live layout before the module code goes away.
+        CancelBackgroundAutoLayout();
+        BlueprintAutoLayout::ShutdownLiveLayout();
+
+        // Persist node size estimates learned during this session.
+        K2AutoLayout::ShutdownNodeSizeCache();
+
+        // Unsubscribe complexity indices from their graphs.
+        K2AutoLayout::ShutdownComplexityIndex();
+
+        // Release cached component layouts.
+        GraphLayout::ClearComponentLayoutCache();
     }
 
     // Internal menu registration helpers.
@@ -32,6 +32,17 @@ K2AutoLayout::FAutoLayoutSettings UBlueprintAutoLayoutSettings::ToAutoLayoutSett
     Settings.VariableGetRankAlignment =
         bPlaceVariableGetUnderDestination ? VariableGetRankAlignment : RankAlignment;
     Settings.bAlignExecChainsHorizontally = bAlignExecChainsHorizontally;
+    Settings.Placement = Placement;
+    Settings.bAdaptiveCrossingReduction = bAdaptiveCrossingReduction;
+    Settings.MaxAdaptiveCrossingSweeps = MaxAdaptiveCrossingSweeps;
+    Settings.bVirtualLongEdgeChains = bVirtualLongEdgeChains;
+    Settings.CrossingReduction = CrossingReduction;
+    Settings.CrossingReductionMaxIterations = CrossingReductionMaxIterations;
+    Settings.CrossingReductionTimeBudgetMs = CrossingReductionTimeBudgetMs;
+    Settings.bCoarsenExecLanes = bCoarsenExecLanes;
+    Settings.CoarsenExecLanesMinNodes = CoarsenExecLanesMinNodes;
+    Settings.bCacheComponentLayouts = bCacheComponentLayouts;
+    Settings.bIncrementalLayout = bIncrementalLayout;
 
     // Apply legacy NodeSpacingX when exec/data spacing are still default.
     const bool bExecDefault =
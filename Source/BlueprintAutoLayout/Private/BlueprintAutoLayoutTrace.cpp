@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Layout trace interface.
+#include "BlueprintAutoLayoutTrace.h"
+
+// Engine dependencies for console commands, locking, and file output.
+#include "HAL/CriticalSection.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+// Layout trace implementation.
+namespace BlueprintAutoLayout
+{
+std::atomic<int32> GTraceVerbosity{static_cast<int32>(ELogVerbosity::NoLogging)};
+
+namespace
+{
+// Capture size used when the console command gives none.
+constexpr int32 kDefaultTraceCaptureLines = 200000;
+
+// Ring buffer holding captured lines; Next is the slot the next line overwrites.
+struct FTraceCapture
+{
+    TArray<FString> Lines;
+    int32 Capacity = 0;
+    int32 Next = 0;
+    int64 Dropped = 0;
+    bool bActive = false;
+};
+
+FTraceCapture GTraceCapture;
+FCriticalSection GTraceCaptureLock;
+std::atomic<bool> GTraceCapturing{false};
+
+// Start a capture from the console.
+void HandleTraceCaptureCommand(const TArray<FString> &Args)
+{
+    const int32 MaxLines =
+        Args.IsEmpty() ? kDefaultTraceCaptureLines : FCString::Atoi(*Args[0]);
+    BeginTraceCapture(MaxLines);
+    UE_LOG(LogBlueprintAutoLayout, Display,
+           TEXT("AutoLayoutTrace: capturing up to %d lines"), FMath::Max(1, MaxLines));
+}
+
+// Stop the capture and write it to a file under the project log directory.
+void HandleTraceDumpCommand(const TArray<FString> &Args)
+{
+    TArray<FString> Lines;
+    if (!EndTraceCapture(Lines)) {
+        UE_LOG(LogBlueprintAutoLayout, Warning,
+               TEXT("AutoLayoutTrace: no capture is running"));
+        return;
+    }
+    const FString DefaultFilename =
+        FPaths::Combine(FPaths::ProjectLogDir(), TEXT("BlueprintAutoLayoutTrace.log"));
+    const FString Filename = Args.IsEmpty() ? DefaultFilename : Args[0];
+    if (!FFileHelper::SaveStringArrayToFile(Lines, *Filename)) {
+        UE_LOG(LogBlueprintAutoLayout, Warning,
+               TEXT("AutoLayoutTrace: failed to write %s"), *Filename);
+        return;
+    }
+    UE_LOG(LogBlueprintAutoLayout, Display,
+           TEXT("AutoLayoutTrace: wrote %d lines to %s"), Lines.Num(), *Filename);
+}
+
+FAutoConsoleCommand GTraceCaptureCommand(
+    TEXT("BlueprintAutoLayout.Trace.Capture"),
+    TEXT("Capture layout trace lines into memory instead of the log. "
+         "Optional argument: maximum lines kept."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&HandleTraceCaptureCommand));
+
+FAutoConsoleCommand GTraceDumpCommand(
+    TEXT("BlueprintAutoLayout.Trace.Dump"),
+    TEXT("Stop the layout trace capture and write it to a file. "
+         "Optional argument: output path."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&HandleTraceDumpCommand));
+} // namespace
+
+void RefreshTraceVerbosity()
+{
+    // A running capture records everything regardless of the category setting.
+    int32 Verbosity = static_cast<int32>(ELogVerbosity::NoLogging);
+#if BLUEPRINTAUTOLAYOUT_TRACE && !NO_LOGGING
+    Verbosity = static_cast<int32>(LogBlueprintAutoLayout.GetVerbosity());
+#endif
+    if (GTraceCapturing.load(std::memory_order_relaxed)) {
+        Verbosity = static_cast<int32>(ELogVerbosity::VeryVerbose);
+    }
+    GTraceVerbosity.store(Verbosity, std::memory_order_relaxed);
+}
+
+void EmitTraceLine(ELogVerbosity::Type Verbosity, const FString &Line)
+{
+    if (GTraceCapturing.load(std::memory_order_relaxed)) {
+        FScopeLock Lock(&GTraceCaptureLock);
+        FTraceCapture &Capture = GTraceCapture;
+        if (Capture.bActive) {
+            if (Capture.Lines.Num() < Capture.Capacity) {
+                Capture.Lines.Add(Line);
+            } else {
+                Capture.Lines[Capture.Next] = Line;
+                ++Capture.Dropped;
+            }
+            Capture.Next = (Capture.Next + 1) % Capture.Capacity;
+            return;
+        }
+    }
+
+    // UE_LOG needs a literal verbosity, so map the trace levels explicitly.
+    if (Verbosity == ELogVerbosity::VeryVerbose) {
+        UE_LOG(LogBlueprintAutoLayout, VeryVerbose, TEXT("%s"), *Line);
+    } else {
+        UE_LOG(LogBlueprintAutoLayout, Verbose, TEXT("%s"), *Line);
+    }
+}
+
+void BeginTraceCapture(int32 MaxLines)
+{
+    {
+        FScopeLock Lock(&GTraceCaptureLock);
+        GTraceCapture = FTraceCapture();
+        GTraceCapture.Capacity = FMath::Max(1, MaxLines);
+        GTraceCapture.bActive = true;
+        GTraceCapturing.store(true, std::memory_order_relaxed);
+    }
+    RefreshTraceVerbosity();
+}
+
+bool EndTraceCapture(TArray<FString> &OutLines)
+{
+    OutLines.Reset();
+    {
+        FScopeLock Lock(&GTraceCaptureLock);
+        FTraceCapture &Capture = GTraceCapture;
+        if (!Capture.bActive) {
+            return false;
+        }
+
+        // Unroll the ring so the oldest kept line comes first.
+        const int32 Count = Capture.Lines.Num();
+        const int32 Start = Count < Capture.Capacity ? 0 : Capture.Next;
+        OutLines.Reserve(Count + 1);
+        if (Capture.Dropped > 0) {
+            OutLines.Add(FString::Printf(TEXT("[%lld earlier lines dropped]"),
+                                         Capture.Dropped));
+        }
+        for (int32 Offset = 0; Offset < Count; ++Offset) {
+            OutLines.Add(MoveTemp(Capture.Lines[(Start + Offset) % Count]));
+        }
+        GTraceCapture = FTraceCapture();
+        GTraceCapturing.store(false, std::memory_order_relaxed);
+    }
+    RefreshTraceVerbosity();
+    return true;
+}
+} // namespace BlueprintAutoLayout
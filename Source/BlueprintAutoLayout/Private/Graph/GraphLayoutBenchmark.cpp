@@ -0,0 +1,498 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Benchmark interface.
+#include "Graph/GraphLayoutBenchmark.h"
+
+// Engine dependencies for captures, random streams, hashing, timing, and memory.
+#include "Graph/GraphLayoutCapture.h"
+#include "Graph/GraphLayoutKeyUtils.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Hash/xxhash.h"
+#include "Math/RandomStream.h"
+
+// Benchmark implementation.
+namespace GraphLayout
+{
+namespace
+{
+// Approximate K2 node metrics so sizes resemble real graphs.
+constexpr float kSyntheticHeaderHeight = 48.0f;
+constexpr float kSyntheticPinHeight = 24.0f;
+constexpr float kSyntheticGetterWidth = 128.0f;
+constexpr float kSyntheticMinWidth = 160.0f;
+
+// Pin layout of a generated node; exec pins precede data pins in each direction.
+struct FSyntheticNodeSpec
+{
+    int32 ExecIn = 0;
+    int32 ExecOut = 0;
+    int32 DataIn = 0;
+    int32 DataOut = 0;
+    bool bIsVariableGet = false;
+};
+
+// Node kinds used by the shape builders.
+constexpr FSyntheticNodeSpec kEventSpec{0, 1, 0, 0};
+constexpr FSyntheticNodeSpec kStatementSpec{1, 1, 2, 1};
+constexpr FSyntheticNodeSpec kBranchSpec{1, 2, 1, 0};
+constexpr FSyntheticNodeSpec kLoopSpec{1, 2, 0, 1};
+constexpr FSyntheticNodeSpec kPureSpec{0, 0, 2, 1};
+constexpr FSyntheticNodeSpec kGetterSpec{0, 0, 0, 1, true};
+
+// Appends nodes and edges with consistent pin indices and stable keys.
+class FSyntheticGraphBuilder
+{
+  public:
+    FSyntheticGraphBuilder(FLayoutGraph &InGraph, int32 InSeed)
+        : Random(InSeed), Graph(InGraph), Seed(InSeed)
+    {
+    }
+
+    int32 Num() const
+    {
+        return Graph.Nodes.Num();
+    }
+
+    int32 AddNode(const FSyntheticNodeSpec &Spec)
+    {
+        const int32 Index = Graph.Nodes.Num();
+        FLayoutNode &Node = Graph.Nodes.AddDefaulted_GetRef();
+        Node.Id = Index;
+        Node.Key.Guid = FGuid(static_cast<uint32>(Seed), 0x5EED0000u,
+                              static_cast<uint32>(Index), 0xB1u);
+        Node.Name = FString::Printf(TEXT("Synthetic_%d"), Index);
+        Node.bHasExecPins = Spec.ExecIn + Spec.ExecOut > 0;
+        Node.bIsVariableGet = Spec.bIsVariableGet;
+        Node.ExecInputPinCount = Spec.ExecIn;
+        Node.ExecOutputPinCount = Spec.ExecOut;
+        Node.InputPinCount = Spec.ExecIn + Spec.DataIn;
+        Node.OutputPinCount = Spec.ExecOut + Spec.DataOut;
+
+        // Size from pin rows; original positions only move the anchor.
+        const int32 PinRows = FMath::Max3(1, Node.InputPinCount, Node.OutputPinCount);
+        const float Width = Spec.bIsVariableGet
+                                ? kSyntheticGetterWidth
+                                : kSyntheticMinWidth + 16.0f * Random.RandRange(0, 10);
+        Node.Size =
+            FVector2f(Width, kSyntheticHeaderHeight + kSyntheticPinHeight * PinRows);
+        Node.Position =
+            FVector2f(Random.RandRange(-4000, 4000), Random.RandRange(-4000, 4000));
+        Specs.Add(Spec);
+        NextDataInput.Add(0);
+        return Index;
+    }
+
+    void AddExecEdge(int32 Src, int32 SrcExecPin, int32 Dst)
+    {
+        AddEdge(Src, SrcExecPin, Dst, 0, EEdgeKind::Exec);
+    }
+
+    // Link a data output of Src into the next free data input of Dst.
+    bool AddDataEdge(int32 Src, int32 Dst)
+    {
+        const FSyntheticNodeSpec &SrcSpec = Specs[Src];
+        const FSyntheticNodeSpec &DstSpec = Specs[Dst];
+        if (Src == Dst || SrcSpec.DataOut == 0 ||
+            NextDataInput[Dst] >= DstSpec.DataIn) {
+            return false;
+        }
+        const int32 SrcPin = SrcSpec.ExecOut + Random.RandHelper(SrcSpec.DataOut);
+        const int32 DstPin = DstSpec.ExecIn + NextDataInput[Dst]++;
+        AddEdge(Src, SrcPin, Dst, DstPin, EEdgeKind::Data);
+        return true;
+    }
+
+    FRandomStream Random;
+
+  private:
+    void AddEdge(int32 Src, int32 SrcPin, int32 Dst, int32 DstPin, EEdgeKind Kind)
+    {
+        const bool bExec = Kind == EEdgeKind::Exec;
+        FLayoutEdge &Edge = Graph.Edges.AddDefaulted_GetRef();
+        Edge.Src = Src;
+        Edge.Dst = Dst;
+        Edge.SrcPinIndex = SrcPin;
+        Edge.DstPinIndex = DstPin;
+        Edge.SrcPinName = FName(bExec ? TEXT("Then") : TEXT("Out"), SrcPin + 1);
+        Edge.DstPinName = FName(bExec ? TEXT("Execute") : TEXT("In"), DstPin + 1);
+        Edge.Kind = Kind;
+    }
+
+    FLayoutGraph &Graph;
+    int32 Seed = 0;
+    TArray<FSyntheticNodeSpec> Specs;
+    TArray<int32> NextDataInput;
+};
+
+// Event followed by statements, with some data links between neighbors.
+void BuildExecChain(FSyntheticGraphBuilder &Builder, int32 Limit)
+{
+    int32 Prev = Builder.AddNode(kEventSpec);
+    while (Builder.Num() < Limit) {
+        const int32 Node = Builder.AddNode(kStatementSpec);
+        Builder.AddExecEdge(Prev, 0, Node);
+        if (Builder.Random.RandHelper(3) == 0) {
+            Builder.AddDataEdge(Prev, Node);
+        }
+        Prev = Node;
+    }
+}
+
+// Breadth-first tree of branches, sequences, and statements.
+void BuildBranchFanOut(FSyntheticGraphBuilder &Builder, int32 Limit)
+{
+    TArray<TPair<int32, int32>> OpenPins;
+    int32 Head = 0;
+    while (Builder.Num() < Limit) {
+        // Start another event when every open exec pin was left unconnected.
+        if (Head == OpenPins.Num()) {
+            OpenPins.Emplace(Builder.AddNode(kEventSpec), 0);
+            continue;
+        }
+        const TPair<int32, int32> Open = OpenPins[Head++];
+        if (Builder.Random.RandHelper(5) == 0) {
+            continue;
+        }
+
+        FSyntheticNodeSpec Spec = kStatementSpec;
+        const int32 Roll = Builder.Random.RandHelper(10);
+        if (Roll < 4) {
+            Spec = kBranchSpec;
+        } else if (Roll < 6) {
+            Spec = FSyntheticNodeSpec{1, Builder.Random.RandRange(2, 4), 0, 0};
+        }
+        const int32 Node = Builder.AddNode(Spec);
+        Builder.AddExecEdge(Open.Key, Open.Value, Node);
+        for (int32 Pin = 0; Pin < Spec.ExecOut; ++Pin) {
+            OpenPins.Emplace(Node, Pin);
+        }
+    }
+}
+
+// Loop nodes whose body chains link back to the loop, then continue on Completed.
+void BuildLoopBackEdges(FSyntheticGraphBuilder &Builder, int32 Limit)
+{
+    int32 Prev = Builder.AddNode(kEventSpec);
+    int32 PrevPin = 0;
+    while (Builder.Num() < Limit) {
+        const int32 Loop = Builder.AddNode(kLoopSpec);
+        Builder.AddExecEdge(Prev, PrevPin, Loop);
+
+        // The body reads the loop index and its tail closes the cycle.
+        int32 BodyTail = Loop;
+        const int32 BodyLength = Builder.Random.RandRange(2, 5);
+        for (int32 Step = 0; Step < BodyLength && Builder.Num() < Limit; ++Step) {
+            const int32 Node = Builder.AddNode(kStatementSpec);
+            Builder.AddExecEdge(BodyTail, 0, Node);
+            Builder.AddDataEdge(Loop, Node);
+            BodyTail = Node;
+        }
+        if (BodyTail != Loop) {
+            Builder.AddExecEdge(BodyTail, 0, Loop);
+        }
+        Prev = Loop;
+        PrevPin = 1;
+    }
+}
+
+// Statements fed by variable getters; recent getters are reused by later nodes.
+void BuildVariableGetFan(FSyntheticGraphBuilder &Builder, int32 Limit)
+{
+    int32 Prev = Builder.AddNode(kEventSpec);
+    TArray<int32> RecentGetters;
+    while (Builder.Num() < Limit) {
+        const int32 Node = Builder.AddNode(kStatementSpec);
+        Builder.AddExecEdge(Prev, 0, Node);
+        const int32 Inputs = Builder.Random.RandRange(1, kStatementSpec.DataIn);
+        for (int32 Input = 0; Input < Inputs && Builder.Num() < Limit; ++Input) {
+            if (!RecentGetters.IsEmpty() && Builder.Random.RandHelper(3) == 0) {
+                const int32 Pick = Builder.Random.RandHelper(RecentGetters.Num());
+                Builder.AddDataEdge(RecentGetters[Pick], Node);
+                continue;
+            }
+            const int32 Getter = Builder.AddNode(kGetterSpec);
+            Builder.AddDataEdge(Getter, Node);
+            RecentGetters.Add(Getter);
+            if (RecentGetters.Num() > 4) {
+                RecentGetters.RemoveAt(0);
+            }
+        }
+        Prev = Node;
+    }
+}
+
+// Small pure data trees; a node that finds no free input forms its own island.
+void BuildDataIslands(FSyntheticGraphBuilder &Builder, int32 Limit)
+{
+    while (Builder.Num() < Limit) {
+        const int32 First = Builder.AddNode(kPureSpec);
+        const int32 IslandSize = Builder.Random.RandRange(3, 7);
+        for (int32 Step = 1; Step < IslandSize && Builder.Num() < Limit; ++Step) {
+            const bool bGetter = Builder.Random.RandHelper(3) == 0;
+            const int32 Node = Builder.AddNode(bGetter ? kGetterSpec : kPureSpec);
+            for (int32 Attempt = 0; Attempt < 4; ++Attempt) {
+                const int32 Target = First + Builder.Random.RandHelper(Node - First);
+                if (Builder.AddDataEdge(Node, Target)) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Run the builder for one shape until the graph holds Limit nodes.
+void BuildShape(ESyntheticGraphShape Shape, FSyntheticGraphBuilder &Builder,
+                int32 Limit)
+{
+    switch (Shape) {
+    case ESyntheticGraphShape::ExecChain:
+        BuildExecChain(Builder, Limit);
+        break;
+    case ESyntheticGraphShape::BranchFanOut:
+        BuildBranchFanOut(Builder, Limit);
+        break;
+    case ESyntheticGraphShape::LoopBackEdges:
+        BuildLoopBackEdges(Builder, Limit);
+        break;
+    case ESyntheticGraphShape::VariableGetFan:
+        BuildVariableGetFan(Builder, Limit);
+        break;
+    case ESyntheticGraphShape::DataIslands:
+        BuildDataIslands(Builder, Limit);
+        break;
+    case ESyntheticGraphShape::Mixed:
+    default:
+        // Alternate random segments of the other shapes.
+        while (Builder.Num() < Limit) {
+            constexpr int32 kSegmentShapes =
+                static_cast<int32>(ESyntheticGraphShape::Mixed);
+            const int32 SegmentShape = Builder.Random.RandHelper(kSegmentShapes);
+            const ESyntheticGraphShape Segment =
+                static_cast<ESyntheticGraphShape>(SegmentShape);
+            const int32 SegmentLimit =
+                FMath::Min(Limit, Builder.Num() + Builder.Random.RandRange(20, 200));
+            BuildShape(Segment, Builder, SegmentLimit);
+        }
+        break;
+    }
+}
+
+// Cached or seeded runs would time lookups instead of the pipeline.
+FLayoutSettings MakeBenchmarkSettings(const FLayoutSettings &Settings)
+{
+    FLayoutSettings Result = Settings;
+    Result.bCacheComponentLayouts = false;
+    Result.bIncrementalLayout = false;
+    return Result;
+}
+
+// Time whole-graph iterations and keep the fastest one's stage stats. Returns false
+// with the first component error if any layout failed.
+bool TimeLayoutCase(const FLayoutGraph &Graph, const TArray<TArray<int32>> &Components,
+                    const FLayoutSettings &Settings, int32 Iterations,
+                    FLayoutBenchmarkResult &Result, FString &OutError)
+{
+    Result.NodeCount = Graph.Nodes.Num();
+    Result.EdgeCount = Graph.Edges.Num();
+    Result.Components = Components.Num();
+
+    bool bAllSucceeded = true;
+    TArray<double> TimesMs;
+    TArray<FLayoutComponentResult> ComponentResults;
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration) {
+        ComponentResults.Reset();
+        ComponentResults.SetNum(Components.Num());
+        FLayoutStats IterationStats;
+        const double StartSeconds = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Components.Num(); ++Index) {
+            FString Error;
+            if (!LayoutComponent(Graph, Components[Index], Settings,
+                                 ComponentResults[Index], &Error)) {
+                if (bAllSucceeded) {
+                    OutError = Error;
+                }
+                bAllSucceeded = false;
+            }
+            IterationStats.Accumulate(ComponentResults[Index].Stats);
+        }
+        const double ElapsedMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+        TimesMs.Add(ElapsedMs);
+
+        // Every iteration must reproduce the first one's positions.
+        const uint64 Hash = HashLayoutResults(Graph, ComponentResults);
+        if (Iteration == 0) {
+            Result.OutputHash = Hash;
+        } else if (Hash != Result.OutputHash) {
+            Result.bDeterministic = false;
+        }
+        if (Iteration == 0 || ElapsedMs < Result.MinMs) {
+            Result.MinMs = ElapsedMs;
+            Result.Stats = IterationStats;
+        }
+    }
+    TimesMs.Sort();
+    Result.MedianMs = TimesMs[TimesMs.Num() / 2];
+    return bAllSucceeded;
+}
+
+// Record memory growth since MemoryBefore and the process peak.
+void SampleMemory(const FPlatformMemoryStats &MemoryBefore,
+                  FLayoutBenchmarkResult &Result)
+{
+    const FPlatformMemoryStats MemoryAfter = FPlatformMemory::GetStats();
+    Result.UsedPhysicalDeltaBytes =
+        MemoryAfter.UsedPhysical > MemoryBefore.UsedPhysical
+            ? MemoryAfter.UsedPhysical - MemoryBefore.UsedPhysical
+            : 0;
+    Result.PeakUsedPhysicalBytes = MemoryAfter.PeakUsedPhysical;
+}
+} // namespace
+
+const TCHAR *LexToString(ESyntheticGraphShape Shape)
+{
+    switch (Shape) {
+    case ESyntheticGraphShape::ExecChain:
+        return TEXT("ExecChain");
+    case ESyntheticGraphShape::BranchFanOut:
+        return TEXT("BranchFanOut");
+    case ESyntheticGraphShape::LoopBackEdges:
+        return TEXT("LoopBackEdges");
+    case ESyntheticGraphShape::VariableGetFan:
+        return TEXT("VariableGetFan");
+    case ESyntheticGraphShape::DataIslands:
+        return TEXT("DataIslands");
+    case ESyntheticGraphShape::Mixed:
+    default:
+        return TEXT("Mixed");
+    }
+}
+
+bool TryParseSyntheticGraphShape(const FString &Text, ESyntheticGraphShape &OutShape)
+{
+    for (int32 Value = 0; Value <= static_cast<int32>(ESyntheticGraphShape::Mixed);
+         ++Value) {
+        const ESyntheticGraphShape Shape = static_cast<ESyntheticGraphShape>(Value);
+        if (Text.Equals(LexToString(Shape), ESearchCase::IgnoreCase)) {
+            OutShape = Shape;
+            return true;
+        }
+    }
+    return false;
+}
+
+void GenerateSyntheticGraph(const FSyntheticGraphParams &Params, FLayoutGraph &OutGraph)
+{
+    OutGraph = FLayoutGraph();
+    const int32 NodeCount = FMath::Max(1, Params.NodeCount);
+    OutGraph.Nodes.Reserve(NodeCount);
+    OutGraph.Edges.Reserve(NodeCount * 2);
+    FSyntheticGraphBuilder Builder(OutGraph, Params.Seed);
+    BuildShape(Params.Shape, Builder, NodeCount);
+    BuildLayoutGraphIndex(OutGraph);
+}
+
+uint64 HashLayoutResults(const FLayoutGraph &Graph,
+                         const TArray<FLayoutComponentResult> &Results)
+{
+    // Collect positions per node index, then hash them in node key order.
+    TArray<TPair<int32, FVector2f>> Positions;
+    const TArray<int32> &NodeIdToIndex = Graph.Index.NodeIdToIndex;
+    for (const FLayoutComponentResult &Result : Results) {
+        for (int32 Index = 0; Index < Result.NodeIds.Num(); ++Index) {
+            const int32 NodeId = Result.NodeIds[Index];
+            if (NodeIdToIndex.IsValidIndex(NodeId) &&
+                NodeIdToIndex[NodeId] != INDEX_NONE) {
+                Positions.Emplace(NodeIdToIndex[NodeId], Result.NodePositions[Index]);
+            }
+        }
+    }
+    Positions.Sort([&Graph](const TPair<int32, FVector2f> &A,
+                            const TPair<int32, FVector2f> &B) {
+        return KeyUtils::NodeKeyLess(Graph.Nodes[A.Key].Key, Graph.Nodes[B.Key].Key);
+    });
+
+    // Round to the integer pixels the editor commits.
+    FXxHash64Builder Builder;
+    for (const TPair<int32, FVector2f> &Pair : Positions) {
+        const FGuid &Guid = Graph.Nodes[Pair.Key].Key.Guid;
+        const int32 Rounded[2] = {FMath::RoundToInt(Pair.Value.X),
+                                  FMath::RoundToInt(Pair.Value.Y)};
+        Builder.Update(&Guid, sizeof(Guid));
+        Builder.Update(Rounded, sizeof(Rounded));
+    }
+    return Builder.Finalize().Hash;
+}
+
+bool RunLayoutBenchmarks(const FLayoutBenchmarkOptions &Options,
+                         TArray<FLayoutBenchmarkResult> &OutResults, FString *OutError)
+{
+    OutResults.Reset();
+    const FLayoutSettings Settings = MakeBenchmarkSettings(Options.Settings);
+    const int32 Iterations = FMath::Max(1, Options.Iterations);
+
+    bool bAllSucceeded = true;
+    for (ESyntheticGraphShape Shape : Options.Shapes) {
+        for (int32 Size : Options.Sizes) {
+            const FPlatformMemoryStats MemoryBefore = FPlatformMemory::GetStats();
+            FLayoutGraph Graph;
+            GenerateSyntheticGraph(FSyntheticGraphParams{Shape, Size, Options.Seed},
+                                   Graph);
+            TArray<TArray<int32>> Components;
+            FindLayoutComponents(Graph, Components);
+
+            FLayoutBenchmarkResult &Result = OutResults.AddDefaulted_GetRef();
+            Result.Shape = Shape;
+            FString Error;
+            if (!TimeLayoutCase(Graph, Components, Settings, Iterations, Result,
+                                Error)) {
+                if (bAllSucceeded && OutError) {
+                    *OutError = FString::Printf(TEXT("%s/%d: %s"), LexToString(Shape),
+                                                Size, *Error);
+                }
+                bAllSucceeded = false;
+            }
+
+            // Sample memory while the graph and results are still alive.
+            SampleMemory(MemoryBefore, Result);
+        }
+    }
+    return bAllSucceeded;
+}
+
+bool RunLayoutReplays(const TArray<FString> &Filenames, int32 Iterations,
+                      TArray<FLayoutBenchmarkResult> &OutResults, FString *OutError)
+{
+    OutResults.Reset();
+    Iterations = FMath::Max(1, Iterations);
+
+    bool bAllSucceeded = true;
+    for (const FString &Filename : Filenames) {
+        // Load first so the capture counts toward the memory delta like a graph.
+        const FPlatformMemoryStats MemoryBefore = FPlatformMemory::GetStats();
+        FLayoutCapture Capture;
+        FString Error;
+        if (!LoadLayoutCapture(Filename, Capture, &Error)) {
+            if (bAllSucceeded && OutError) {
+                *OutError = Error;
+            }
+            bAllSucceeded = false;
+            continue;
+        }
+
+        FLayoutBenchmarkResult &Result = OutResults.AddDefaulted_GetRef();
+        Result.ReplayFile = Filename;
+        Result.ReplayLabel = Capture.Label;
+        if (!TimeLayoutCase(Capture.Graph, Capture.Components,
+                            MakeBenchmarkSettings(Capture.Settings), Iterations,
+                            Result, Error)) {
+            if (bAllSucceeded && OutError) {
+                *OutError = FString::Printf(TEXT("%s: %s"), *Filename, *Error);
+            }
+            bAllSucceeded = false;
+        }
+        SampleMemory(MemoryBefore, Result);
+    }
+    return bAllSucceeded;
+}
+} // namespace GraphLayout
@@ -0,0 +1,231 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Capture interface.
+#include "Graph/GraphLayoutCapture.h"
+
+// Engine dependencies for archives, file I/O, console commands, and locking.
+#include "BlueprintAutoLayoutLog.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Capture implementation.
+namespace GraphLayout
+{
+namespace
+{
+// File signature ("BALC") and format version. The settings block lists every
+// FLayoutSettings field, so adding a field needs a version bump; older files load
+// with defaults for the fields they predate.
+constexpr uint32 kCaptureMagic = 0x434C4142;
+constexpr int32 kCaptureVersion = 2;
+constexpr int32 kCaptureVersionPlacement = 2;
+
+// Pending request set by RequestLayoutCapture.
+FString GCaptureRequest;
+FCriticalSection GCaptureRequestLock;
+
+// Names go through strings so the file does not depend on the name table.
+void SerializeName(FArchive &Ar, FName &Name)
+{
+    FString Text = Name.ToString();
+    Ar << Text;
+    if (Ar.IsLoading()) {
+        Name = FName(*Text);
+    }
+}
+
+// Serialize an element count; loads reject counts the remaining bytes cannot hold.
+bool SerializeCount(FArchive &Ar, int32 Count, int32 &OutCount)
+{
+    OutCount = Count;
+    Ar << OutCount;
+    return !Ar.IsError() && OutCount >= 0 &&
+           (!Ar.IsLoading() || OutCount <= Ar.TotalSize() - Ar.Tell());
+}
+
+// Settings in declaration order, except for fields added by later versions.
+void SerializeSettings(FArchive &Ar, int32 Version, FLayoutSettings &Settings)
+{
+    Ar << Settings.NodeSpacingX;
+    Ar << Settings.NodeSpacingXExec;
+    Ar << Settings.NodeSpacingXData;
+    Ar << Settings.NodeSpacingYExec;
+    Ar << Settings.NodeSpacingYData;
+    Ar << Settings.VariableGetMinLength;
+    Ar << Settings.RankAlignment;
+    Ar << Settings.VariableGetRankAlignment;
+    Ar << Settings.bAlignExecChainsHorizontally;
+    Ar << Settings.bAdaptiveCrossingReduction;
+    Ar << Settings.MaxAdaptiveCrossingSweeps;
+    Ar << Settings.bVirtualLongEdgeChains;
+    Ar << Settings.CrossingReduction;
+    Ar << Settings.CrossingReductionMaxIterations;
+    Ar << Settings.CrossingReductionTimeBudgetMs;
+    Ar << Settings.bCoarsenExecLanes;
+    Ar << Settings.CoarsenExecLanesMinNodes;
+    Ar << Settings.bCacheComponentLayouts;
+    Ar << Settings.bIncrementalLayout;
+    if (Version >= kCaptureVersionPlacement) {
+        Ar << Settings.Placement;
+    }
+}
+
+// Input fields of a node; working outputs are recomputed by every run.
+void SerializeNode(FArchive &Ar, FLayoutNode &Node)
+{
+    Ar << Node.Id;
+    Ar << Node.Key.Guid;
+    Ar << Node.Name;
+    Ar << Node.Size;
+    Ar << Node.bHasExecPins;
+    Ar << Node.bIsVariableGet;
+    Ar << Node.bIsReroute;
+    Ar << Node.ExecInputPinCount;
+    Ar << Node.ExecOutputPinCount;
+    Ar << Node.InputPinCount;
+    Ar << Node.OutputPinCount;
+    Ar << Node.Position;
+}
+
+// Input fields of an edge; stable keys are rebuilt per component.
+void SerializeEdge(FArchive &Ar, FLayoutEdge &Edge)
+{
+    Ar << Edge.Src;
+    Ar << Edge.Dst;
+    Ar << Edge.SrcPinIndex;
+    Ar << Edge.DstPinIndex;
+    SerializeName(Ar, Edge.SrcPinName);
+    SerializeName(Ar, Edge.DstPinName);
+    Ar << Edge.Kind;
+}
+
+// Serialize the whole capture in either direction; false on a malformed file.
+bool SerializeCapture(FArchive &Ar, FString &Label, FLayoutGraph &Graph,
+                      TArray<TArray<int32>> &Components, FLayoutSettings &Settings)
+{
+    uint32 Magic = kCaptureMagic;
+    int32 Version = kCaptureVersion;
+    Ar << Magic;
+    Ar << Version;
+    if (Ar.IsError() || Magic != kCaptureMagic || Version < 1 ||
+        Version > kCaptureVersion) {
+        return false;
+    }
+    Ar << Label;
+    SerializeSettings(Ar, Version, Settings);
+
+    int32 Count = 0;
+    if (!SerializeCount(Ar, Graph.Nodes.Num(), Count)) {
+        return false;
+    }
+    Graph.Nodes.SetNum(Count);
+    for (FLayoutNode &Node : Graph.Nodes) {
+        SerializeNode(Ar, Node);
+    }
+    if (!SerializeCount(Ar, Graph.Edges.Num(), Count)) {
+        return false;
+    }
+    Graph.Edges.SetNum(Count);
+    for (FLayoutEdge &Edge : Graph.Edges) {
+        SerializeEdge(Ar, Edge);
+    }
+    if (!SerializeCount(Ar, Components.Num(), Count)) {
+        return false;
+    }
+    Components.SetNum(Count);
+    for (TArray<int32> &Component : Components) {
+        Ar << Component;
+    }
+    return !Ar.IsError();
+}
+
+// Arm a capture from the console; the default file sits next to the trace dump.
+void HandleCaptureNextCommand(const TArray<FString> &Args)
+{
+    const FString DefaultFilename =
+        FPaths::Combine(FPaths::ProjectLogDir(), TEXT("BlueprintAutoLayout.capture"));
+    const FString Filename = Args.IsEmpty() ? DefaultFilename : Args[0];
+    RequestLayoutCapture(Filename);
+    UE_LOG(LogBlueprintAutoLayout, Display,
+           TEXT("AutoLayoutCapture: the next layout run will be saved to %s"),
+           *Filename);
+}
+
+FAutoConsoleCommand GCaptureNextCommand(
+    TEXT("BlueprintAutoLayout.Capture.Next"),
+    TEXT("Save the input of the next auto layout run for offline replay. "
+         "Optional argument: output path."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&HandleCaptureNextCommand));
+} // namespace
+
+bool SaveLayoutCapture(const FString &Label, const FLayoutGraph &Graph,
+                       const TArray<TArray<int32>> &Components,
+                       const FLayoutSettings &Settings, const FString &Filename,
+                       FString *OutError)
+{
+    // A saving archive only reads through these references.
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    FString MutableLabel = Label;
+    SerializeCapture(Writer, MutableLabel, const_cast<FLayoutGraph &>(Graph),
+                     const_cast<TArray<TArray<int32>> &>(Components),
+                     const_cast<FLayoutSettings &>(Settings));
+    if (!FFileHelper::SaveArrayToFile(Bytes, *Filename)) {
+        if (OutError) {
+            *OutError = FString::Printf(TEXT("Failed to write %s."), *Filename);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool LoadLayoutCapture(const FString &Filename, FLayoutCapture &OutCapture,
+                       FString *OutError)
+{
+    OutCapture = FLayoutCapture();
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Filename)) {
+        if (OutError) {
+            *OutError = FString::Printf(TEXT("Failed to read %s."), *Filename);
+        }
+        return false;
+    }
+    FMemoryReader Reader(Bytes);
+    if (!SerializeCapture(Reader, OutCapture.Label, OutCapture.Graph,
+                          OutCapture.Components, OutCapture.Settings)) {
+        if (OutError) {
+            *OutError = FString::Printf(
+                TEXT("%s is not a layout capture of version %d or older."),
+                *Filename, kCaptureVersion);
+        }
+        OutCapture = FLayoutCapture();
+        return false;
+    }
+
+    // Unknown component node ids are reported by LayoutComponent itself.
+    BuildLayoutGraphIndex(OutCapture.Graph);
+    return true;
+}
+
+void RequestLayoutCapture(const FString &Filename)
+{
+    FScopeLock Lock(&GCaptureRequestLock);
+    GCaptureRequest = Filename;
+}
+
+bool TakeLayoutCaptureRequest(FString &OutFilename)
+{
+    FScopeLock Lock(&GCaptureRequestLock);
+    if (GCaptureRequest.IsEmpty()) {
+        return false;
+    }
+    OutFilename = MoveTemp(GCaptureRequest);
+    GCaptureRequest.Reset();
+    return true;
+}
+} // namespace GraphLayout
@@ -5,27 +5,41 @@
 
 // Logging support for layout diagnostics.
 #include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutTrace.h"
+
+// Parallel barycenter evaluation for wide ranks.
+#include "Async/ParallelFor.h"
+
+// Wall-clock budget checks for median rounds.
+#include "HAL/PlatformTime.h"
 
 // Crossing reduction implementation for the Sugiyama layout pass.
 namespace GraphLayout
 {
 namespace
 {
+// Ranks at least this wide compute barycenters in parallel batches.
+constexpr int32 kParallelBarycenterMinRankNodes = 256;
+constexpr int32 kParallelBarycenterBatchSize = 64;
+
+// Upper bound on transpose passes per median round; every pass that swaps lowers
+// the crossing count, so this only caps pathological inputs.
+constexpr int32 kMaxTransposePasses = 16;
+
 // Log rank orders for debugging and determinism checks.
 void LogRankOrders(const TCHAR *Label, const TCHAR *Stage, const FSugiyamaGraph &Graph,
-                   const TArray<TArray<int32>> &RankNodes)
+                   const FLayoutIndexLists &RankNodes)
 {
     if (!ShouldDumpSugiyamaDetail(Graph)) {
         return;
     }
     for (int32 Rank = 0; Rank < RankNodes.Num(); ++Rank) {
-        const TArray<int32> &Layer = RankNodes[Rank];
+        const TLayoutArray<int32> &Layer = RankNodes[Rank];
         for (int32 OrderIndex = 0; OrderIndex < Layer.Num(); ++OrderIndex) {
             const int32 NodeIndex = Layer[OrderIndex];
             const FSugiyamaNode &Node = Graph.Nodes[NodeIndex];
-            UE_LOG(LogBlueprintAutoLayout, Verbose,
-                   TEXT("Sugiyama[%s] %s rank=%d order=%d node=%s"), Label, Stage, Rank,
-                   OrderIndex, *BuildNodeKeyString(Node.Key));
+            LAYOUT_LOG(Verbose, TEXT("Sugiyama[%s] %s rank=%d order=%d node=%s"), Label,
+                       Stage, Rank, OrderIndex, *BuildNodeKeyString(Node.Key));
         }
     }
 }
@@ -38,13 +52,157 @@ struct FOrderConstraint
 };
 
 // Convert a pin index into a fractional offset for barycenter computation.
-double GetPinOffset(const FSugiyamaNode &Node, int32 PinIndex, int32 PinCount)
+double GetPinOffset(int32 PinIndex, int32 PinCount)
 {
     const int32 Denom = FMath::Max(1, PinCount);
     return static_cast<double>(PinIndex) / static_cast<double>(Denom);
 }
 
-// Barycenter computation result for a node in a rank.
+// Flat CSR neighbor list for one sweep direction. Each node's range holds only
+// neighbors on the adjacent rank, already sorted by pin key.
+struct FSweepAdjacency
+{
+    // Slots owned by node I are [Offsets[I], Offsets[I + 1]).
+    TLayoutArray<int32> Offsets;
+
+    // Per-slot neighbor node and precomputed neighbor pin data.
+    TLayoutArray<int32> Neighbors;
+    TLayoutArray<int32> PinIndices;
+    TLayoutArray<double> PinOffsets;
+
+    // Per-slot flag consumed by the sweep policy's exec filtering.
+    TLayoutArray<bool> bFiltered;
+};
+
+// Structure-of-arrays view of the Sugiyama graph used by the sweep hot loop.
+// Names and keys stay in FSugiyamaGraph, which acts as the cold side table for
+// logging and tie-breaking.
+struct FSweepGraph
+{
+    // Hot per-node state indexed like FSugiyamaGraph::Nodes.
+    TLayoutArray<int32> Rank;
+    TLayoutArray<int32> Order;
+
+    // Incoming neighbors feed forward sweeps; outgoing neighbors feed backward ones.
+    FSweepAdjacency InAdjacency;
+    FSweepAdjacency OutAdjacency;
+
+    // Long-edge chain per node (INDEX_NONE outside chains) and each chain's first
+    // and last dummy, whose single slots reach the chain's source and destination.
+    TLayoutArray<int32> ChainOf;
+    TLayoutArray<int32> ChainHead;
+    TLayoutArray<int32> ChainTail;
+};
+
+// Build one CSR adjacency direction. Ranks and pin keys are fixed during crossing
+// reduction, so rank filtering and pin-key sorting happen here exactly once.
+void BuildSweepAdjacency(const FSugiyamaGraph &Graph, const FSweepGraph &Flat,
+                         bool bIncoming, FSweepAdjacency &OutAdjacency)
+{
+    const int32 NodeCount = Graph.Nodes.Num();
+    const int32 RankDelta = bIncoming ? -1 : 1;
+    auto IsSweepEdge = [&](const FSugiyamaEdge &Edge) {
+        if (Edge.Src == Edge.Dst) {
+            return false;
+        }
+        const int32 Owner = bIncoming ? Edge.Dst : Edge.Src;
+        const int32 Neighbor = bIncoming ? Edge.Src : Edge.Dst;
+        return Flat.Rank[Neighbor] == Flat.Rank[Owner] + RankDelta;
+    };
+
+    // Count slots per owning node, then convert counts into offsets.
+    OutAdjacency.Offsets.Init(0, NodeCount + 1);
+    for (const FSugiyamaEdge &Edge : Graph.Edges) {
+        if (IsSweepEdge(Edge)) {
+            ++OutAdjacency.Offsets[(bIncoming ? Edge.Dst : Edge.Src) + 1];
+        }
+    }
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        OutAdjacency.Offsets[NodeIndex + 1] += OutAdjacency.Offsets[NodeIndex];
+    }
+
+    // Scatter edge indices into their owner ranges in edge index order.
+    const int32 SlotCount = OutAdjacency.Offsets.Last();
+    TLayoutArray<int32> SlotEdges;
+    SlotEdges.SetNumUninitialized(SlotCount);
+    TLayoutArray<int32> Cursor = OutAdjacency.Offsets;
+    for (int32 EdgeIndex = 0; EdgeIndex < Graph.Edges.Num(); ++EdgeIndex) {
+        const FSugiyamaEdge &Edge = Graph.Edges[EdgeIndex];
+        if (IsSweepEdge(Edge)) {
+            SlotEdges[Cursor[bIncoming ? Edge.Dst : Edge.Src]++] = EdgeIndex;
+        }
+    }
+
+    // Sort each owner range by the neighbor-side pin key.
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        const int32 Begin = OutAdjacency.Offsets[NodeIndex];
+        const int32 Count = OutAdjacency.Offsets[NodeIndex + 1] - Begin;
+        MakeArrayView(SlotEdges.GetData() + Begin, Count).Sort([&](int32 A, int32 B) {
+            const FSugiyamaEdge &EdgeA = Graph.Edges[A];
+            const FSugiyamaEdge &EdgeB = Graph.Edges[B];
+            return bIncoming ? PinKeyLess(GetEdgeSrcPin(Graph, EdgeA),
+                                          GetEdgeSrcPin(Graph, EdgeB))
+                             : PinKeyLess(GetEdgeDstPin(Graph, EdgeA),
+                                          GetEdgeDstPin(Graph, EdgeB));
+        });
+    }
+
+    // Resolve the per-slot sweep data from the sorted edges.
+    OutAdjacency.Neighbors.SetNumUninitialized(SlotCount);
+    OutAdjacency.PinIndices.SetNumUninitialized(SlotCount);
+    OutAdjacency.PinOffsets.SetNumUninitialized(SlotCount);
+    OutAdjacency.bFiltered.SetNumUninitialized(SlotCount);
+    for (int32 Slot = 0; Slot < SlotCount; ++Slot) {
+        const FSugiyamaEdge &Edge = Graph.Edges[SlotEdges[Slot]];
+        const bool bExecEdge = Edge.Kind == EEdgeKind::Exec;
+        const int32 Neighbor = bIncoming ? Edge.Src : Edge.Dst;
+        const FSugiyamaNode &NeighborNode = Graph.Nodes[Neighbor];
+        const int32 PinIndex = bIncoming ? Edge.SrcPinIndex : Edge.DstPinIndex;
+        const int32 PinCount =
+            bIncoming ? NeighborNode.OutputPinCount : NeighborNode.InputPinCount;
+        OutAdjacency.Neighbors[Slot] = Neighbor;
+        OutAdjacency.PinIndices[Slot] = PinIndex;
+        OutAdjacency.PinOffsets[Slot] = GetPinOffset(PinIndex, PinCount);
+
+        // Forward sweeps ignore data edges from nodes without exec outputs; backward
+        // sweeps may ignore exec edges and neighbors with exec inputs.
+        OutAdjacency.bFiltered[Slot] =
+            bIncoming ? (NeighborNode.ExecOutputPinCount == 0 && !bExecEdge)
+                      : (bExecEdge || NeighborNode.ExecInputPinCount > 0);
+    }
+}
+
+// Build the flat sweep representation once after dummy insertion.
+void BuildSweepGraph(const FSugiyamaGraph &Graph, FSweepGraph &OutFlat)
+{
+    const int32 NodeCount = Graph.Nodes.Num();
+    OutFlat.Rank.SetNumUninitialized(NodeCount);
+    OutFlat.Order.SetNumUninitialized(NodeCount);
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        const FSugiyamaNode &Node = Graph.Nodes[NodeIndex];
+        OutFlat.Rank[NodeIndex] = Node.Rank;
+        OutFlat.Order[NodeIndex] = Node.Order;
+    }
+    BuildSweepAdjacency(Graph, OutFlat, true, OutFlat.InAdjacency);
+    BuildSweepAdjacency(Graph, OutFlat, false, OutFlat.OutAdjacency);
+
+    // Expand the chain ranges into per-node lookups.
+    const int32 ChainCount = Graph.Chains.Num();
+    OutFlat.ChainOf.Init(INDEX_NONE, NodeCount);
+    OutFlat.ChainHead.SetNumUninitialized(ChainCount);
+    OutFlat.ChainTail.SetNumUninitialized(ChainCount);
+    for (int32 ChainIndex = 0; ChainIndex < ChainCount; ++ChainIndex) {
+        const FSugiyamaChain &Chain = Graph.Chains[ChainIndex];
+        OutFlat.ChainHead[ChainIndex] = Chain.FirstNode;
+        OutFlat.ChainTail[ChainIndex] = Chain.FirstNode + Chain.NodeCount - 1;
+        for (int32 Offset = 0; Offset < Chain.NodeCount; ++Offset) {
+            OutFlat.ChainOf[Chain.FirstNode + Offset] = ChainIndex;
+        }
+    }
+}
+
+// Barycenter computation result for a node in a rank. Median rounds store the
+// weighted median in Barycenter, so both heuristics share the sweep.
 struct FOrderItem
 {
     int32 NodeIndex = INDEX_NONE;
@@ -55,8 +213,11 @@ struct FOrderItem
 // Sweep policy for forward (incoming-edge) passes.
 struct FForwardSweepPolicy
 {
-    // Incoming edge lists indexed by node.
-    const TArray<TArray<int32>> &EdgeList;
+    // Incoming neighbor slots indexed by node.
+    const FSweepAdjacency &Adjacency;
+
+    // Chain dummies whose slot reaches the chain source.
+    const TLayoutArray<int32> &ChainEnds;
 
     // Accessors describing forward sweep behavior.
     const TCHAR *Direction() const
@@ -67,42 +228,20 @@ struct FForwardSweepPolicy
     {
         return TEXT("in-edges");
     }
-    int32 NeighborRankDelta() const
+    bool ShouldSkip(int32 Slot, bool /*bSkipExecPins*/) const
     {
-        return -1;
-    }
-    const TArray<int32> &GetEdgesForNode(int32 NodeIndex) const
-    {
-        return EdgeList[NodeIndex];
-    }
-    int32 GetNeighborIndex(const FSugiyamaEdge &Edge) const
-    {
-        return Edge.Src;
-    }
-    const FPinKey &GetPinKey(const FSugiyamaEdge &Edge) const
-    {
-        return Edge.SrcPin;
-    }
-    int32 GetPinIndex(const FSugiyamaEdge &Edge) const
-    {
-        return Edge.SrcPinIndex;
-    }
-    int32 GetPinCount(const FSugiyamaNode &Node) const
-    {
-        return Node.OutputPinCount;
-    }
-    bool ShouldSkip(const FSugiyamaEdge &Edge, const FSugiyamaNode &Neighbor,
-                    bool /*bSkipExecPins*/) const
-    {
-        return Neighbor.ExecOutputPinCount == 0 && Edge.Kind != EEdgeKind::Exec;
+        return Adjacency.bFiltered[Slot];
     }
 };
 
 // Sweep policy for backward (outgoing-edge) passes.
 struct FBackwardSweepPolicy
 {
-    // Outgoing edge lists indexed by node.
-    const TArray<TArray<int32>> &EdgeList;
+    // Outgoing neighbor slots indexed by node.
+    const FSweepAdjacency &Adjacency;
+
+    // Chain dummies whose slot reaches the chain destination.
+    const TLayoutArray<int32> &ChainEnds;
 
     // Accessors describing backward sweep behavior.
     const TCHAR *Direction() const
@@ -113,141 +252,231 @@ struct FBackwardSweepPolicy
     {
         return TEXT("out-edges");
     }
-    int32 NeighborRankDelta() const
+    bool ShouldSkip(int32 Slot, bool bSkipExecPins) const
     {
-        return 1;
+        return bSkipExecPins && Adjacency.bFiltered[Slot];
     }
-    const TArray<int32> &GetEdgesForNode(int32 NodeIndex) const
-    {
-        return EdgeList[NodeIndex];
+};
+
+// Barycenter of a chain dummy taken from the chain endpoint on the sweep side. The
+// endpoint's position is rescaled from its rank width to the adjacent rank's, so
+// every dummy of the chain sorts at the same relative position. Returns false when
+// the policy filters the endpoint slot.
+template <typename PolicyType>
+bool ComputeChainBarycenter(const FSweepGraph &Flat,
+                            const FLayoutIndexLists &RankNodes, int32 Rank,
+                            int32 Step, int32 ChainIndex, const PolicyType &Policy,
+                            bool bSkipExecPins, double &OutBarycenter)
+{
+    const int32 End = Policy.ChainEnds[ChainIndex];
+    const int32 Slot = Policy.Adjacency.Offsets[End];
+    if (Slot == Policy.Adjacency.Offsets[End + 1] ||
+        Policy.ShouldSkip(Slot, bSkipExecPins)) {
+        return false;
     }
-    int32 GetNeighborIndex(const FSugiyamaEdge &Edge) const
-    {
-        return Edge.Dst;
+    const int32 EndpointIndex = Policy.Adjacency.Neighbors[Slot];
+    const double EndpointWidth = RankNodes[Flat.Rank[EndpointIndex]].Num();
+    const double AdjacentWidth = RankNodes[Rank - Step].Num();
+    const double PinOffset = Policy.Adjacency.PinOffsets[Slot];
+    const double Position = static_cast<double>(Flat.Order[EndpointIndex]) + PinOffset;
+    OutBarycenter = (Position + 0.5) * AdjacentWidth / EndpointWidth - 0.5;
+    return true;
+}
+
+// Barycenter of one node from the fixed order of the adjacent rank. Reads only state
+// that the sweep does not write until the whole rank is computed, so nodes of a
+// rank may be evaluated concurrently.
+template <typename PolicyType>
+FOrderItem ComputeBarycenter(const FSweepGraph &Flat,
+                             const FLayoutIndexLists &RankNodes, int32 Rank,
+                             int32 Step, int32 NodeIndex, const PolicyType &Policy,
+                             bool bSkipExecPins, bool bVirtualChains)
+{
+    FOrderItem Item;
+    Item.NodeIndex = NodeIndex;
+    Item.Barycenter = static_cast<double>(Flat.Order[NodeIndex]);
+
+    // Virtual chains skip the neighbor scan and follow their endpoint.
+    const int32 ChainIndex = Flat.ChainOf[NodeIndex];
+    if (bVirtualChains && ChainIndex != INDEX_NONE) {
+        if (ComputeChainBarycenter(Flat, RankNodes, Rank, Step, ChainIndex, Policy,
+                                   bSkipExecPins, Item.Barycenter)) {
+            Item.NeighborCount = 1;
+        }
+        return Item;
     }
-    const FPinKey &GetPinKey(const FSugiyamaEdge &Edge) const
-    {
-        return Edge.DstPin;
+
+    // Accumulate neighbor orders and pin offsets over the node's flat slot range;
+    // slots are already limited to the adjacent rank and sorted by pin key. The sum
+    // runs in slot order on every path so results do not depend on threading.
+    const FSweepAdjacency &Adjacency = Policy.Adjacency;
+    const int32 Begin = Adjacency.Offsets[NodeIndex];
+    const int32 End = Adjacency.Offsets[NodeIndex + 1];
+    double Sum = 0.0;
+    int32 Count = 0;
+    for (int32 Slot = Begin; Slot < End; ++Slot) {
+        if (Policy.ShouldSkip(Slot, bSkipExecPins)) {
+            continue;
+        }
+        Sum += static_cast<double>(Flat.Order[Adjacency.Neighbors[Slot]]) +
+               Adjacency.PinOffsets[Slot];
+        ++Count;
     }
-    int32 GetPinIndex(const FSugiyamaEdge &Edge) const
-    {
-        return Edge.DstPinIndex;
+    if (Count > 0) {
+        Item.Barycenter = Sum / Count;
     }
-    int32 GetPinCount(const FSugiyamaNode &Node) const
-    {
-        return Node.InputPinCount;
+    Item.NeighborCount = Count;
+    return Item;
+}
+
+// Weighted median of one node's neighbor positions on the adjacent rank (Gansner
+// et al.): even counts interpolate toward the side whose positions are tighter.
+// Like ComputeBarycenter it reads only fixed state and may run concurrently.
+template <typename PolicyType>
+FOrderItem ComputeMedian(const FSweepGraph &Flat, const FLayoutIndexLists &RankNodes,
+                         int32 Rank, int32 Step, int32 NodeIndex,
+                         const PolicyType &Policy, bool bSkipExecPins,
+                         bool bVirtualChains)
+{
+    FOrderItem Item;
+    Item.NodeIndex = NodeIndex;
+    Item.Barycenter = static_cast<double>(Flat.Order[NodeIndex]);
+
+    // A chain dummy has one endpoint, whose position is also its median.
+    const int32 ChainIndex = Flat.ChainOf[NodeIndex];
+    if (bVirtualChains && ChainIndex != INDEX_NONE) {
+        if (ComputeChainBarycenter(Flat, RankNodes, Rank, Step, ChainIndex, Policy,
+                                   bSkipExecPins, Item.Barycenter)) {
+            Item.NeighborCount = 1;
+        }
+        return Item;
     }
-    bool ShouldSkip(const FSugiyamaEdge &Edge, const FSugiyamaNode &Neighbor,
-                    bool bSkipExecPins) const
-    {
-        return bSkipExecPins &&
-               (Edge.Kind == EEdgeKind::Exec || Neighbor.ExecInputPinCount > 0);
+
+    // Collect positions locally; worker threads have no layout arena mark.
+    const FSweepAdjacency &Adjacency = Policy.Adjacency;
+    TArray<double, TInlineAllocator<16>> Positions;
+    for (int32 Slot = Adjacency.Offsets[NodeIndex];
+         Slot < Adjacency.Offsets[NodeIndex + 1]; ++Slot) {
+        if (!Policy.ShouldSkip(Slot, bSkipExecPins)) {
+            Positions.Add(static_cast<double>(Flat.Order[Adjacency.Neighbors[Slot]]) +
+                          Adjacency.PinOffsets[Slot]);
+        }
     }
-};
+    const int32 Count = Positions.Num();
+    Item.NeighborCount = Count;
+    if (Count == 0) {
+        return Item;
+    }
+    Positions.Sort();
+    const int32 Mid = Count / 2;
+    if (Count % 2 == 1) {
+        Item.Barycenter = Positions[Mid];
+    } else if (Count == 2) {
+        Item.Barycenter = 0.5 * (Positions[0] + Positions[1]);
+    } else {
+        const double Left = Positions[Mid - 1] - Positions[0];
+        const double Right = Positions[Count - 1] - Positions[Mid];
+        Item.Barycenter =
+            Left + Right > 0.0
+                ? (Positions[Mid - 1] * Right + Positions[Mid] * Left) / (Left + Right)
+                : 0.5 * (Positions[Mid - 1] + Positions[Mid]);
+    }
+    return Item;
+}
 
-// Perform a directional sweep to update node ordering by barycenter.
+// Log the neighbor slots that feed one node's barycenter.
 template <typename PolicyType>
-void RunSweep(FSugiyamaGraph &Graph, TArray<TArray<int32>> &RankNodes,
+void LogBarycenterInputs(const FSugiyamaGraph &Graph, const FSweepGraph &Flat,
+                         const TCHAR *Label, int32 Sweep, int32 Rank, int32 NodeIndex,
+                         const PolicyType &Policy, bool bSkipExecPins)
+{
+    const FSweepAdjacency &Adjacency = Policy.Adjacency;
+    const int32 Begin = Adjacency.Offsets[NodeIndex];
+    const int32 End = Adjacency.Offsets[NodeIndex + 1];
+    LAYOUT_LOG(Verbose,
+               TEXT("Sugiyama[%s] Sweep%d %s rank=%d node=%s calculating "
+                    "barycenter from %d %s"),
+               Label, Sweep, Policy.Direction(), Rank,
+               *BuildNodeKeyString(Graph.Nodes[NodeIndex].Key), End - Begin,
+               Policy.EdgeLabel());
+    for (int32 Slot = Begin; Slot < End; ++Slot) {
+        const int32 NeighborIndex = Adjacency.Neighbors[Slot];
+        const int32 NeighborOrder = Flat.Order[NeighborIndex];
+        if (Policy.ShouldSkip(Slot, bSkipExecPins)) {
+            // Pins filtered out by the sweep policy do not contribute.
+            LAYOUT_LOG(Verbose,
+                       TEXT("Sugiyama[%s]   skip neighbor node=%s order=%d "
+                            "pinIndex=%d (filtered)"),
+                       Label, *BuildNodeKeyString(Graph.Nodes[NeighborIndex].Key),
+                       NeighborOrder, Adjacency.PinIndices[Slot]);
+            continue;
+        }
+        LAYOUT_LOG(Verbose,
+                   TEXT("Sugiyama[%s]   consider neighbor node=%s order=%d "
+                        "pinIndex=%d pinoffset=%.3f"),
+                   Label, *BuildNodeKeyString(Graph.Nodes[NeighborIndex].Key),
+                   NeighborOrder, Adjacency.PinIndices[Slot],
+                   Adjacency.PinOffsets[Slot]);
+    }
+}
+
+// Perform a directional sweep to update node ordering by barycenter, or by
+// weighted median when bMedian is set.
+template <typename PolicyType>
+void RunSweep(const FSugiyamaGraph &Graph, FSweepGraph &Flat,
+              FLayoutIndexLists &RankNodes, TLayoutArray<FOrderItem> &Items,
               bool bCrossDetail, const TCHAR *Label, int32 Sweep, int32 StartRank,
-              int32 EndRank, int32 Step, const PolicyType &Policy, bool bSkipExecPins)
+              int32 EndRank, int32 Step, const PolicyType &Policy, bool bSkipExecPins,
+              bool bVirtualChains, const TLayoutArray<bool> *SweepRanks,
+              bool bMedian = false)
 {
     for (int32 Rank = StartRank; Rank != EndRank; Rank += Step) {
-        TArray<int32> &Layer = RankNodes[Rank];
+        TLayoutArray<int32> &Layer = RankNodes[Rank];
         if (Layer.IsEmpty()) {
             continue;
         }
+        // Incremental runs keep the seeded order of ranks an edit did not touch.
+        if (SweepRanks && !(*SweepRanks)[Rank]) {
+            continue;
+        }
 
-        // Prepare storage for barycenter results for this rank.
-        TArray<FOrderItem> Items;
-        Items.Reserve(Layer.Num());
-
-        // Compute barycenters for each node in the layer.
-        for (int32 NodeIndex : Layer) {
-            const FSugiyamaNode &Node = Graph.Nodes[NodeIndex];
-            const TArray<int32> &NodeEdges = Policy.GetEdgesForNode(NodeIndex);
-            if (bCrossDetail) {
-                UE_LOG(LogBlueprintAutoLayout, Verbose,
-                       TEXT("Sugiyama[%s] Sweep%d %s rank=%d node=%s calculating "
-                            "barycenter from %d %s"),
-                       Label, Sweep, Policy.Direction(), Rank,
-                       *BuildNodeKeyString(Node.Key), NodeEdges.Num(),
-                       Policy.EdgeLabel());
-            }
-            double Sum = 0.0;
-            int32 Count = 0;
-            TArray<int32> NeighborEdges;
-            for (int32 EdgeIndex : NodeEdges) {
-                const FSugiyamaEdge &Edge = Graph.Edges[EdgeIndex];
-                const int32 NeighborIndex = Policy.GetNeighborIndex(Edge);
-                if (Graph.Nodes[NeighborIndex].Rank !=
-                    Rank + Policy.NeighborRankDelta()) {
-                    continue;
-                }
-                NeighborEdges.Add(EdgeIndex);
-            }
-
-            // Sort neighbors by pin key for stable processing.
-            NeighborEdges.Sort([&](int32 A, int32 B) {
-                return PinKeyLess(Policy.GetPinKey(Graph.Edges[A]),
-                                  Policy.GetPinKey(Graph.Edges[B]));
-            });
-
-            // Accumulate barycenter contributions from neighbor orders and pins.
-            for (int32 EdgeIndex : NeighborEdges) {
-                const FSugiyamaEdge &Edge = Graph.Edges[EdgeIndex];
-                const int32 NeighborIndex = Policy.GetNeighborIndex(Edge);
-                const FSugiyamaNode &Neighbor = Graph.Nodes[NeighborIndex];
-                const int32 PinIndex = Policy.GetPinIndex(Edge);
-                if (Policy.ShouldSkip(Edge, Neighbor, bSkipExecPins)) {
-                    // Skip pins filtered out by the sweep policy for barycenter
-                    // calculation.
-                    if (bCrossDetail) {
-                        UE_LOG(LogBlueprintAutoLayout, Verbose,
-                               TEXT("Sugiyama[%s]   skip neighbor node=%s order=%d "
-                                    "pinIndex=%d (filtered)"),
-                               Label, *BuildNodeKeyString(Neighbor.Key), Neighbor.Order,
-                               PinIndex);
-                    }
-                    continue;
-                }
+        // Reuse the caller's barycenter storage; it is reserved for the widest rank.
+        // Each node writes only its own item.
+        Items.SetNumUninitialized(Layer.Num(), EAllowShrinking::No);
+        auto ComputeItem = [&](int32 Index) {
+            Items[Index] =
+                bMedian ? ComputeMedian(Flat, RankNodes, Rank, Step, Layer[Index],
+                                        Policy, bSkipExecPins, bVirtualChains)
+                        : ComputeBarycenter(Flat, RankNodes, Rank, Step, Layer[Index],
+                                            Policy, bSkipExecPins, bVirtualChains);
+        };
 
-                // Compute the pin offset contribution for this neighbor.
-                double PinOffset =
-                    GetPinOffset(Neighbor, PinIndex, Policy.GetPinCount(Neighbor));
-                if (bCrossDetail) {
-                    UE_LOG(LogBlueprintAutoLayout, Verbose,
-                           TEXT("Sugiyama[%s]   consider neighbor node=%s order=%d "
-                                "pinIndex=%d pinoffset=%.3f"),
-                           Label, *BuildNodeKeyString(Neighbor.Key), Neighbor.Order,
-                           PinIndex, PinOffset);
+        // Wide ranks compute barycenters in parallel; detail dumps stay serial so
+        // the log keeps its per-node order.
+        if (!bCrossDetail && Layer.Num() >= kParallelBarycenterMinRankNodes) {
+            ParallelFor(TEXT("BlueprintAutoLayout.Barycenters"), Layer.Num(),
+                        kParallelBarycenterBatchSize, ComputeItem);
+        } else {
+            for (int32 Index = 0; Index < Layer.Num(); ++Index) {
+                const int32 NodeIndex = Layer[Index];
+                const bool bChainNode = Flat.ChainOf[NodeIndex] != INDEX_NONE;
+                if (bCrossDetail && !(bVirtualChains && bChainNode)) {
+                    LogBarycenterInputs(Graph, Flat, Label, Sweep, Rank, NodeIndex,
+                                        Policy, bSkipExecPins);
                 }
-
-                // Add the neighbor order plus pin offset to the barycenter sum.
-                Sum += static_cast<double>(Neighbor.Order) + PinOffset;
-                ++Count;
-            }
-
-            // Record the barycenter for this node.
-            FOrderItem Item;
-            Item.NodeIndex = NodeIndex;
-            if (Count == 0) {
-                Item.Barycenter = static_cast<double>(Node.Order);
-            } else {
-                Item.Barycenter = Sum / Count;
+                ComputeItem(Index);
             }
-            Item.NeighborCount = Count;
-            Items.Add(Item);
         }
 
         // Emit per-node barycenter details when verbose logging is enabled.
         if (bCrossDetail) {
             for (const FOrderItem &Item : Items) {
-                UE_LOG(LogBlueprintAutoLayout, Verbose,
-                       TEXT("Sugiyama[%s] Sweep%d %s rank=%d node=%s ")
-                           TEXT("bary=%.3f neighbors=%d"),
-                       Label, Sweep, Policy.Direction(), Rank,
-                       *BuildNodeKeyString(Graph.Nodes[Item.NodeIndex].Key),
-                       Item.Barycenter, Item.NeighborCount);
+                LAYOUT_LOG(Verbose,
+                           TEXT("Sugiyama[%s] Sweep%d %s rank=%d node=%s ")
+                               TEXT("bary=%.3f neighbors=%d"),
+                           Label, Sweep, Policy.Direction(), Rank,
+                           *BuildNodeKeyString(Graph.Nodes[Item.NodeIndex].Key),
+                           Item.Barycenter, Item.NeighborCount);
             }
         }
 
@@ -260,11 +489,11 @@ void RunSweep(FSugiyamaGraph &Graph, TArray<TArray<int32>> &RankNodes,
                                Graph.Nodes[B.NodeIndex].Key);
         });
 
-        // Apply the sorted order back to node state and layer list.
+        // Apply the sorted order back to the flat state and layer list.
         Layer.Reset(Items.Num());
         for (int32 Index = 0; Index < Items.Num(); ++Index) {
             const int32 NodeIndex = Items[Index].NodeIndex;
-            Graph.Nodes[NodeIndex].Order = Index;
+            Flat.Order[NodeIndex] = Index;
             Layer.Add(NodeIndex);
         }
 
@@ -272,23 +501,196 @@ void RunSweep(FSugiyamaGraph &Graph, TArray<TArray<int32>> &RankNodes,
         if (bCrossDetail) {
             for (int32 Index = 0; Index < Items.Num(); ++Index) {
                 const int32 NodeIndex = Items[Index].NodeIndex;
-                UE_LOG(LogBlueprintAutoLayout, Verbose,
-                       TEXT("Sugiyama[%s] Sweep%d %s rank=%d order=%d node=%s"), Label,
-                       Sweep, Policy.Direction(), Rank, Index,
-                       *BuildNodeKeyString(Graph.Nodes[NodeIndex].Key));
+                LAYOUT_LOG(Verbose,
+                           TEXT("Sugiyama[%s] Sweep%d %s rank=%d order=%d node=%s"),
+                           Label, Sweep, Policy.Direction(), Rank, Index,
+                           *BuildNodeKeyString(Graph.Nodes[NodeIndex].Key));
+            }
+        }
+    }
+}
+
+// Count crossings between a rank and the next one with the Barth-Juenger-Mutzel
+// accumulator tree in O(E log V). NorthLayer must be sorted by order.
+int64 CountRankPairCrossings(const FSweepGraph &Flat,
+                             const TLayoutArray<int32> &NorthLayer, int32 SouthCount,
+                             TLayoutArray<int32> &SouthOrders,
+                             TLayoutArray<int32> &Tree)
+{
+    // Collect south endpoints in (north order, south order) sequence.
+    const FSweepAdjacency &Adjacency = Flat.OutAdjacency;
+    SouthOrders.Reset();
+    for (int32 NodeIndex : NorthLayer) {
+        const int32 First = SouthOrders.Num();
+        for (int32 Slot = Adjacency.Offsets[NodeIndex];
+             Slot < Adjacency.Offsets[NodeIndex + 1]; ++Slot) {
+            SouthOrders.Add(Flat.Order[Adjacency.Neighbors[Slot]]);
+        }
+        MakeArrayView(SouthOrders.GetData() + First, SouthOrders.Num() - First).Sort();
+    }
+    if (SouthOrders.Num() < 2) {
+        return 0;
+    }
+
+    // Size a complete binary tree with one leaf per south position.
+    int32 FirstLeaf = 1;
+    while (FirstLeaf < SouthCount) {
+        FirstLeaf *= 2;
+    }
+    Tree.Reset();
+    Tree.SetNumZeroed(2 * FirstLeaf - 1);
+    FirstLeaf -= 1;
+
+    // Insert each endpoint, adding the already inserted endpoints to its right.
+    int64 Crossings = 0;
+    for (int32 SouthOrder : SouthOrders) {
+        int32 Index = SouthOrder + FirstLeaf;
+        ++Tree[Index];
+        while (Index > 0) {
+            if (Index % 2 == 1) {
+                Crossings += Tree[Index + 1];
+            }
+            Index = (Index - 1) / 2;
+            ++Tree[Index];
+        }
+    }
+    return Crossings;
+}
+
+// Total crossings over all adjacent rank pairs for the current orders.
+int64 CountAllCrossings(const FSweepGraph &Flat, const FLayoutIndexLists &RankNodes,
+                        int32 MaxRank, TLayoutArray<int32> &SouthOrders,
+                        TLayoutArray<int32> &Tree)
+{
+    int64 Total = 0;
+    for (int32 Rank = 0; Rank < MaxRank; ++Rank) {
+        Total += CountRankPairCrossings(Flat, RankNodes[Rank],
+                                        RankNodes[Rank + 1].Num(), SouthOrders, Tree);
+    }
+    return Total;
+}
+
+// Sorted neighbor orders of every node of one rank toward one adjacent rank. List I
+// belongs to the node at layer position I when the lists were gathered.
+struct FRankNeighborOrders
+{
+    TLayoutArray<int32> Offsets;
+    TLayoutArray<int32> Orders;
+
+    TConstArrayView<int32> GetList(int32 ListIndex) const
+    {
+        return TConstArrayView<int32>(Orders.GetData() + Offsets[ListIndex],
+                                      Offsets[ListIndex + 1] - Offsets[ListIndex]);
+    }
+};
+
+// Gather and sort the neighbor orders of a whole rank, reusing the buffers.
+void GatherRankNeighborOrders(const FSweepAdjacency &Adjacency,
+                              const TLayoutArray<int32> &Order,
+                              const TLayoutArray<int32> &Layer,
+                              FRankNeighborOrders &OutLists)
+{
+    OutLists.Offsets.Reset(Layer.Num() + 1);
+    OutLists.Orders.Reset();
+    OutLists.Offsets.Add(0);
+    for (int32 NodeIndex : Layer) {
+        const int32 Begin = OutLists.Orders.Num();
+        for (int32 Slot = Adjacency.Offsets[NodeIndex];
+             Slot < Adjacency.Offsets[NodeIndex + 1]; ++Slot) {
+            OutLists.Orders.Add(Order[Adjacency.Neighbors[Slot]]);
+        }
+        const int32 Count = OutLists.Orders.Num() - Begin;
+        MakeArrayView(OutLists.Orders).Slice(Begin, Count).Sort();
+        OutLists.Offsets.Add(OutLists.Orders.Num());
+    }
+}
+
+// Crossings between the edges of a left node and a right node toward one adjacent
+// rank: pairs whose left-side neighbor sits strictly right of the other's.
+int64 CountPairCrossings(TConstArrayView<int32> LeftOrders,
+                         TConstArrayView<int32> RightOrders)
+{
+    int64 Crossings = 0;
+    int32 Below = 0;
+    for (int32 LeftOrder : LeftOrders) {
+        while (Below < RightOrders.Num() && RightOrders[Below] < LeftOrder) {
+            ++Below;
+        }
+        Crossings += Below;
+    }
+    return Crossings;
+}
+
+// Swap adjacent nodes of each rank while that strictly lowers their crossings with
+// both neighboring ranks. Scans run left to right in ascending rank order, so the
+// outcome is deterministic. Returns the number of swaps.
+int32 RunTranspose(FSweepGraph &Flat, FLayoutIndexLists &RankNodes,
+                   const TLayoutArray<bool> *SweepRanks, double DeadlineSeconds)
+{
+    // Neighbor ranks stay fixed while one rank is scanned, so each rank gathers and
+    // sorts its neighbor orders once and a swap only swaps which list is where.
+    FRankNeighborOrders InLists;
+    FRankNeighborOrders OutLists;
+    TLayoutArray<int32> ListAt;
+    int32 Swaps = 0;
+    for (int32 Pass = 0; Pass < kMaxTransposePasses; ++Pass) {
+        bool bSwapped = false;
+        for (int32 Rank = 0; Rank < RankNodes.Num(); ++Rank) {
+            if (SweepRanks && !(*SweepRanks)[Rank]) {
+                continue;
             }
+            TLayoutArray<int32> &Layer = RankNodes[Rank];
+            if (Layer.Num() < 2) {
+                continue;
+            }
+            GatherRankNeighborOrders(Flat.InAdjacency, Flat.Order, Layer, InLists);
+            GatherRankNeighborOrders(Flat.OutAdjacency, Flat.Order, Layer, OutLists);
+            ListAt.Reset(Layer.Num());
+            for (int32 Index = 0; Index < Layer.Num(); ++Index) {
+                ListAt.Add(Index);
+            }
+            for (int32 Index = 0; Index + 1 < Layer.Num(); ++Index) {
+                const int32 ListU = ListAt[Index];
+                const int32 ListV = ListAt[Index + 1];
+                const TConstArrayView<int32> InU = InLists.GetList(ListU);
+                const TConstArrayView<int32> InV = InLists.GetList(ListV);
+                const TConstArrayView<int32> OutU = OutLists.GetList(ListU);
+                const TConstArrayView<int32> OutV = OutLists.GetList(ListV);
+                const int64 Kept =
+                    CountPairCrossings(InU, InV) + CountPairCrossings(OutU, OutV);
+                const int64 Exchanged =
+                    CountPairCrossings(InV, InU) + CountPairCrossings(OutV, OutU);
+                if (Exchanged < Kept) {
+                    const int32 U = Layer[Index];
+                    const int32 V = Layer[Index + 1];
+                    Layer[Index] = V;
+                    Layer[Index + 1] = U;
+                    Flat.Order[V] = Index;
+                    Flat.Order[U] = Index + 1;
+                    ListAt[Index] = ListV;
+                    ListAt[Index + 1] = ListU;
+                    ++Swaps;
+                    bSwapped = true;
+                }
+            }
+        }
+        if (!bSwapped || FPlatformTime::Seconds() >= DeadlineSeconds) {
+            break;
         }
     }
+    return Swaps;
 }
 
 // Apply ordering constraints for min-len-zero edges after sweeps.
-void ApplyMinLenZeroOrdering(FSugiyamaGraph &Graph, TArray<TArray<int32>> &RankNodes)
+void ApplyMinLenZeroOrdering(FSugiyamaGraph &Graph, FLayoutIndexLists &RankNodes)
 {
-    // Gather min-len-zero edges that keep source and destination on the same rank.
-    TMap<int32, TArray<int32>> ZeroLenByDst;
-    ZeroLenByDst.Reserve(Graph.Nodes.Num());
-    TSet<int32> ZeroLenSources;
-    ZeroLenSources.Reserve(Graph.Nodes.Num());
+    // Gather min-len-zero edges that keep source and destination on the same rank,
+    // listed per destination node.
+    const int32 NodeCount = Graph.Nodes.Num();
+    FLayoutIndexLists ZeroLenByDst;
+    ZeroLenByDst.SetNum(NodeCount);
+    TLayoutArray<bool> bZeroLenSource;
+    bZeroLenSource.Init(false, NodeCount);
 
     // Filter edges down to min-len-zero links between real nodes on the same layer.
     for (int32 EdgeIndex = 0; EdgeIndex < Graph.Edges.Num(); ++EdgeIndex) {
@@ -311,13 +713,13 @@ void ApplyMinLenZeroOrdering(FSugiyamaGraph &Graph, TArray<TArray<int32>> &RankN
         if (SrcNode.Rank != DstNode.Rank) {
             continue;
         }
-        ZeroLenByDst.FindOrAdd(Edge.Dst).Add(EdgeIndex);
-        ZeroLenSources.Add(Edge.Src);
+        ZeroLenByDst[Edge.Dst].Add(EdgeIndex);
+        bZeroLenSource[Edge.Src] = true;
     }
 
     // Sort each destination's sources by the destination pin index.
-    for (TPair<int32, TArray<int32>> &Pair : ZeroLenByDst) {
-        Pair.Value.Sort([&](int32 A, int32 B) {
+    for (TLayoutArray<int32> &EdgeList : ZeroLenByDst) {
+        EdgeList.Sort([&](int32 A, int32 B) {
             const FSugiyamaEdge &EdgeA = Graph.Edges[A];
             const FSugiyamaEdge &EdgeB = Graph.Edges[B];
             if (EdgeA.DstPinIndex != EdgeB.DstPinIndex) {
@@ -327,50 +729,45 @@ void ApplyMinLenZeroOrdering(FSugiyamaGraph &Graph, TArray<TArray<int32>> &RankN
         });
     }
 
+    // Track nodes already placed into a rebuilt layer. Min-len-zero sources share
+    // their destination's rank, so one flag per node serves every layer.
+    TLayoutArray<bool> bAdded;
+    bAdded.Init(false, NodeCount);
+    TLayoutArray<int32> NewLayer;
+    TLayoutArray<int32> Stack;
+
     // Rebuild each layer so min-len-zero sources follow their destination.
     for (int32 Rank = 0; Rank < RankNodes.Num(); ++Rank) {
-        TArray<int32> &Layer = RankNodes[Rank];
+        TLayoutArray<int32> &Layer = RankNodes[Rank];
         if (Layer.IsEmpty()) {
             continue;
         }
-
-        // Track which nodes have already been placed into the new order.
-        TSet<int32> Added;
-        Added.Reserve(Layer.Num());
-        TArray<int32> NewLayer;
-        NewLayer.Reserve(Layer.Num());
+        NewLayer.Reset(Layer.Num());
 
         // Append a node and its chained min-len-zero sources in pin order.
         auto AppendNodeAndSources = [&](int32 StartNode) {
-            TArray<int32> Stack;
+            Stack.Reset();
             Stack.Add(StartNode);
             while (!Stack.IsEmpty()) {
                 const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
-                if (Added.Contains(NodeIndex)) {
+                if (bAdded[NodeIndex]) {
                     continue;
                 }
-                Added.Add(NodeIndex);
+                bAdded[NodeIndex] = true;
                 NewLayer.Add(NodeIndex);
 
                 // Queue min-len-zero sources for this destination in pin order.
-                const TArray<int32> *EdgeList = ZeroLenByDst.Find(NodeIndex);
-                if (!EdgeList) {
-                    continue;
-                }
-                for (int32 EdgeListIndex = EdgeList->Num() - 1; EdgeListIndex >= 0;
+                const TLayoutArray<int32> &EdgeList = ZeroLenByDst[NodeIndex];
+                for (int32 EdgeListIndex = EdgeList.Num() - 1; EdgeListIndex >= 0;
                      --EdgeListIndex) {
-                    const int32 EdgeIndex = (*EdgeList)[EdgeListIndex];
-                    Stack.Add(Graph.Edges[EdgeIndex].Src);
+                    Stack.Add(Graph.Edges[EdgeList[EdgeListIndex]].Src);
                 }
             }
         };
 
         // Walk the original order and defer min-len-zero sources to their destination.
         for (int32 NodeIndex : Layer) {
-            if (Added.Contains(NodeIndex)) {
-                continue;
-            }
-            if (ZeroLenSources.Contains(NodeIndex)) {
+            if (bAdded[NodeIndex] || bZeroLenSource[NodeIndex]) {
                 continue;
             }
             AppendNodeAndSources(NodeIndex);
@@ -378,7 +775,7 @@ void ApplyMinLenZeroOrdering(FSugiyamaGraph &Graph, TArray<TArray<int32>> &RankN
 
         // Append any remaining nodes that could not be placed via destinations.
         for (int32 NodeIndex : Layer) {
-            if (Added.Contains(NodeIndex)) {
+            if (bAdded[NodeIndex]) {
                 continue;
             }
             AppendNodeAndSources(NodeIndex);
@@ -389,14 +786,14 @@ void ApplyMinLenZeroOrdering(FSugiyamaGraph &Graph, TArray<TArray<int32>> &RankN
             const int32 NodeIndex = NewLayer[Index];
             Graph.Nodes[NodeIndex].Order = Index;
         }
-        Layer = MoveTemp(NewLayer);
+        Swap(Layer, NewLayer);
     }
 }
 } // namespace
 
 // Initialize per-rank ordering deterministically before crossing reduction.
 void AssignInitialOrder(FSugiyamaGraph &Graph, int32 MaxRank,
-                        TArray<TArray<int32>> &RankNodes, const TCHAR *Label)
+                        FLayoutIndexLists &RankNodes, const TCHAR *Label)
 {
     // Group nodes by rank before applying per-layer ordering.
     RankNodes.SetNum(MaxRank + 1);
@@ -427,7 +824,7 @@ void AssignInitialOrder(FSugiyamaGraph &Graph, int32 MaxRank,
 
     // Apply the ordering per rank and persist node order fields.
     for (int32 Rank = 0; Rank < RankNodes.Num(); ++Rank) {
-        TArray<int32> &Layer = RankNodes[Rank];
+        TLayoutArray<int32> &Layer = RankNodes[Rank];
         Layer.Sort(ExecLayerLess);
         // Persist the sorted order onto nodes for later sweeps.
         for (int32 Order = 0; Order < Layer.Num(); ++Order) {
@@ -439,92 +836,304 @@ void AssignInitialOrder(FSugiyamaGraph &Graph, int32 MaxRank,
     LogRankOrders(Label, TEXT("InitialOrder"), Graph, RankNodes);
 }
 
+// Refill the slots held by known nodes in prior order; other nodes keep their slot.
+void ApplyPriorOrders(FSugiyamaGraph &Graph, FLayoutIndexLists &RankNodes,
+                      const TLayoutArray<int32> &PriorOrders, const TCHAR *Label)
+{
+    TLayoutArray<int32> Slots;
+    TLayoutArray<int32> Known;
+    for (TLayoutArray<int32> &Layer : RankNodes) {
+        Slots.Reset();
+        Known.Reset();
+        for (int32 Slot = 0; Slot < Layer.Num(); ++Slot) {
+            if (PriorOrders[Layer[Slot]] != INDEX_NONE) {
+                Slots.Add(Slot);
+                Known.Add(Layer[Slot]);
+            }
+        }
+        Known.Sort([&](int32 A, int32 B) {
+            if (PriorOrders[A] != PriorOrders[B]) {
+                return PriorOrders[A] < PriorOrders[B];
+            }
+            return NodeKeyLess(Graph.Nodes[A].Key, Graph.Nodes[B].Key);
+        });
+        for (int32 Index = 0; Index < Slots.Num(); ++Index) {
+            Layer[Slots[Index]] = Known[Index];
+        }
+
+        // Persist the seeded order onto nodes for later sweeps.
+        for (int32 Order = 0; Order < Layer.Num(); ++Order) {
+            Graph.Nodes[Layer[Order]].Order = Order;
+        }
+    }
+
+    // Log seeded orders for diagnostics.
+    LogRankOrders(Label, TEXT("PriorOrder"), Graph, RankNodes);
+}
+
 // Sweep forward and backward to reduce edge crossings using barycenters.
-void RunCrossingReduction(FSugiyamaGraph &Graph, int32 MaxRank, int32 NumSweeps,
-                          TArray<TArray<int32>> &RankNodes, const TCHAR *Label)
+int32 RunCrossingReduction(FSugiyamaGraph &Graph, int32 MaxRank, int32 NumSweeps,
+                           bool bAdaptiveSweeps, bool bVirtualChains,
+                           FLayoutIndexLists &RankNodes, const TCHAR *Label,
+                           const TLayoutArray<bool> *SweepRanks, int64 *OutCrossings)
 {
     // Cache detail flags to control log verbosity levels.
     const bool bDumpDetail = ShouldDumpSugiyamaDetail(Graph);
-    const bool bCrossDetail = UE_LOG_ACTIVE(LogBlueprintAutoLayout, VeryVerbose);
+    const bool bCrossDetail = LAYOUT_TRACE_ACTIVE(VeryVerbose);
     if (MaxRank <= 0 || NumSweeps <= 0) {
         if (bDumpDetail) {
-            UE_LOG(LogBlueprintAutoLayout, Verbose,
-                   TEXT("Sugiyama[%s] CrossingReduction: skipped maxRank=%d ")
-                       TEXT("sweeps=%d"),
-                   Label, MaxRank, NumSweeps);
+            LAYOUT_LOG(Verbose,
+                       TEXT("Sugiyama[%s] CrossingReduction: skipped maxRank=%d ")
+                           TEXT("sweeps=%d"),
+                       Label, MaxRank, NumSweeps);
         }
-        return;
+        return 0;
     }
 
     // Log the sweep setup when detailed logging is enabled.
     if (bDumpDetail) {
-        UE_LOG(LogBlueprintAutoLayout, Verbose,
-               TEXT("Sugiyama[%s] CrossingReduction: sweeps=%d maxRank=%d"), Label,
-               NumSweeps, MaxRank);
+        LAYOUT_LOG(Verbose,
+                   TEXT("Sugiyama[%s] CrossingReduction: sweeps=%d maxRank=%d "
+                        "chains=%d virtual=%d"),
+                   Label, NumSweeps, MaxRank, Graph.Chains.Num(),
+                   bVirtualChains ? 1 : 0);
     }
 
-    // Build adjacency lists for sweep barycenter calculations.
-    TArray<TArray<int32>> InEdges;
-    TArray<TArray<int32>> OutEdges;
-    InEdges.SetNum(Graph.Nodes.Num());
-    OutEdges.SetNum(Graph.Nodes.Num());
-
-    // Populate incoming and outgoing edge lists per node.
-    for (int32 EdgeIndex = 0; EdgeIndex < Graph.Edges.Num(); ++EdgeIndex) {
-        const FSugiyamaEdge &Edge = Graph.Edges[EdgeIndex];
-        if (Edge.Src == Edge.Dst) {
-            continue;
-        }
-        OutEdges[Edge.Src].Add(EdgeIndex);
-        InEdges[Edge.Dst].Add(EdgeIndex);
-    }
+    // Build the flat sweep representation once; sweeps never touch cold node data.
+    FSweepGraph Flat;
+    BuildSweepGraph(Graph, Flat);
 
     // Keep each rank list aligned to the node order field.
     auto SortRankByOrder = [&](int32 Rank) {
-        TArray<int32> &Layer = RankNodes[Rank];
+        TLayoutArray<int32> &Layer = RankNodes[Rank];
         Layer.Sort([&](int32 A, int32 B) {
-            const FSugiyamaNode &NodeA = Graph.Nodes[A];
-            const FSugiyamaNode &NodeB = Graph.Nodes[B];
-            if (NodeA.Order != NodeB.Order) {
-                return NodeA.Order < NodeB.Order;
+            if (Flat.Order[A] != Flat.Order[B]) {
+                return Flat.Order[A] < Flat.Order[B];
             }
-            return NodeKeyLess(NodeA.Key, NodeB.Key);
+            return NodeKeyLess(Graph.Nodes[A].Key, Graph.Nodes[B].Key);
         });
     };
 
     // Initialize sweep policies for forward and backward passes.
-    const FForwardSweepPolicy ForwardPolicy{InEdges};
-    const FBackwardSweepPolicy BackwardPolicy{OutEdges};
+    const FForwardSweepPolicy ForwardPolicy{Flat.InAdjacency, Flat.ChainHead};
+    const FBackwardSweepPolicy BackwardPolicy{Flat.OutAdjacency, Flat.ChainTail};
 
-    // Run alternating forward/backward sweeps to reduce crossings.
-    for (int32 Sweep = 0; Sweep < NumSweeps; ++Sweep) {
+    // Reserve barycenter storage once so sweeps do not allocate.
+    int32 MaxLayerSize = 0;
+    for (const TLayoutArray<int32> &Layer : RankNodes) {
+        MaxLayerSize = FMath::Max(MaxLayerSize, Layer.Num());
+    }
+    TLayoutArray<FOrderItem> Items;
+    Items.Reserve(MaxLayerSize);
+
+    // Helpers for the individual passes shared by both sweep schedules.
+    auto RunForwardSweep = [&](int32 Sweep) {
         // Forward sweep: order each rank by barycenter of incoming neighbors.
-        RunSweep(Graph, RankNodes, bCrossDetail, Label, Sweep, 1, MaxRank + 1, 1,
-                 ForwardPolicy, false);
+        RunSweep(Graph, Flat, RankNodes, Items, bCrossDetail, Label, Sweep, 1,
+                 MaxRank + 1, 1, ForwardPolicy, false, bVirtualChains, SweepRanks);
+    };
+    auto RunBackwardSweep = [&](int32 Sweep, bool bSkipExecPins) {
+        RunSweep(Graph, Flat, RankNodes, Items, bCrossDetail, Label, Sweep,
+                 MaxRank - 1, -1, -1, BackwardPolicy, bSkipExecPins, bVirtualChains,
+                 SweepRanks);
+    };
+    auto SortAllRanks = [&]() {
+        // Re-sort each rank by the updated order field after the sweeps.
+        for (int32 Rank = 0; Rank < RankNodes.Num(); ++Rank) {
+            SortRankByOrder(Rank);
+        }
+    };
+
+    int32 SweepsRun = 0;
+    if (!bAdaptiveSweeps) {
+        // Run alternating forward/backward sweeps to reduce crossings.
+        SweepsRun = NumSweeps;
+        for (int32 Sweep = 0; Sweep < NumSweeps; ++Sweep) {
+            RunForwardSweep(Sweep);
+
+            // 早期終了したexecレーンのorderは決定不能なので、最後に1回だけforwardを回す。
+            // 最後のbackwardはデータノードをexecノードと同じorderに揃えるために必要。
+            if (Sweep < NumSweeps - 1) {
+                RunBackwardSweep(Sweep, true);
+            }
 
-        // 早期終了したexecレーンのorderは決定不能なので、最後に1回だけforwardを回す。
-        // 最後のbackwardはデータノードをexecノードと同じorderに揃えるために必要。
-        if (Sweep < NumSweeps - 1) {
-            RunSweep(Graph, RankNodes, bCrossDetail, Label, Sweep, MaxRank - 1, -1, -1,
-                     BackwardPolicy, true);
+            // Run an additional backward sweep without exec pin filtering.
+            if (Sweep < NumSweeps - 2) {
+                RunBackwardSweep(Sweep, false);
+            }
+            SortAllRanks();
         }
+    } else {
+        TLayoutArray<int32> SouthOrders;
+        TLayoutArray<int32> Tree;
+        auto CountCrossings = [&]() {
+            return CountAllCrossings(Flat, RankNodes, MaxRank, SouthOrders, Tree);
+        };
+
+        // Run full sweep rounds while they keep strictly reducing crossings, leaving
+        // room for the same two closing rounds as the fixed schedule.
+        const int32 MaxSweeps = FMath::Max(2, NumSweeps);
+        int64 BestCrossings = CountCrossings();
+        TLayoutArray<int32> BestOrder = Flat.Order;
+        TLayoutArray<int32> PreviousOrder;
+        int32 Sweep = 0;
+        while (Sweep < MaxSweeps - 2 && BestCrossings > 0) {
+            PreviousOrder = Flat.Order;
+            RunForwardSweep(Sweep);
+            RunBackwardSweep(Sweep, true);
+            RunBackwardSweep(Sweep, false);
+            SortAllRanks();
+            ++Sweep;
 
-        // Run an additional backward sweep without exec pin filtering.
-        if (Sweep < NumSweeps - 2) {
-            RunSweep(Graph, RankNodes, bCrossDetail, Label, Sweep, MaxRank - 1, -1, -1,
-                     BackwardPolicy, false);
+            // Stop once a round leaves every order unchanged.
+            if (Flat.Order == PreviousOrder) {
+                break;
+            }
+
+            // Keep the best order seen; stop at the first round that does not improve.
+            const int64 Crossings = CountCrossings();
+            if (bDumpDetail) {
+                LAYOUT_LOG(
+                    Verbose,
+                    TEXT("Sugiyama[%s] CrossingReduction: sweep=%d crossings=%lld"),
+                    Label, Sweep - 1, Crossings);
+            }
+            if (Crossings >= BestCrossings) {
+                Flat.Order = BestOrder;
+                SortAllRanks();
+                break;
+            }
+            BestCrossings = Crossings;
+            BestOrder = Flat.Order;
         }
 
-        // Re-sort each rank by the updated order field after the sweeps.
-        for (int32 Rank = 0; Rank < RankNodes.Num(); ++Rank) {
-            SortRankByOrder(Rank);
+        // Closing rounds match the last two rounds of the fixed schedule.
+        RunForwardSweep(Sweep);
+        RunBackwardSweep(Sweep, true);
+        SortAllRanks();
+        RunForwardSweep(Sweep + 1);
+        SortAllRanks();
+        SweepsRun = Sweep + 2;
+        if (bDumpDetail) {
+            LAYOUT_LOG(Verbose,
+                       TEXT("Sugiyama[%s] CrossingReduction: adaptive sweeps=%d "
+                            "crossings=%lld"),
+                       Label, Sweep + 2, CountCrossings());
         }
     }
 
+    // Copy the swept orders back onto the Sugiyama nodes.
+    for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex) {
+        Graph.Nodes[NodeIndex].Order = Flat.Order[NodeIndex];
+    }
+
     // Enforce min-len-zero ordering after crossing reduction sweeps.
     ApplyMinLenZeroOrdering(Graph, RankNodes);
 
+    // Count the final crossings, including the min-len-zero reordering.
+    if (OutCrossings) {
+        for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex) {
+            Flat.Order[NodeIndex] = Graph.Nodes[NodeIndex].Order;
+        }
+        TLayoutArray<int32> SouthOrders;
+        TLayoutArray<int32> Tree;
+        *OutCrossings = CountAllCrossings(Flat, RankNodes, MaxRank, SouthOrders, Tree);
+    }
+
     // Emit the final per-rank orders for debugging.
     LogRankOrders(Label, TEXT("CrossingFinalOrder"), Graph, RankNodes);
+    return SweepsRun;
+}
+
+// Median rounds with transpose refinement, keeping the best order seen.
+int32 RunMedianCrossingReduction(FSugiyamaGraph &Graph, int32 MaxRank,
+                                 const FCrossingReductionParams &Params,
+                                 FLayoutIndexLists &RankNodes, const TCHAR *Label,
+                                 const TLayoutArray<bool> *SweepRanks,
+                                 int64 &OutCrossings, int32 &OutSwaps)
+{
+    const bool bDumpDetail = ShouldDumpSugiyamaDetail(Graph);
+    const bool bCrossDetail = LAYOUT_TRACE_ACTIVE(VeryVerbose);
+    OutCrossings = 0;
+    OutSwaps = 0;
+    if (MaxRank <= 0) {
+        return 0;
+    }
+    const double DeadlineSeconds =
+        Params.TimeBudgetMs > 0.0
+            ? FPlatformTime::Seconds() + Params.TimeBudgetMs / 1000.0
+            : TNumericLimits<double>::Max();
+
+    // Share the flat sweep graph and policies with the barycenter engine.
+    FSweepGraph Flat;
+    BuildSweepGraph(Graph, Flat);
+    const FForwardSweepPolicy ForwardPolicy{Flat.InAdjacency, Flat.ChainHead};
+    const FBackwardSweepPolicy BackwardPolicy{Flat.OutAdjacency, Flat.ChainTail};
+    int32 MaxLayerSize = 0;
+    for (const TLayoutArray<int32> &Layer : RankNodes) {
+        MaxLayerSize = FMath::Max(MaxLayerSize, Layer.Num());
+    }
+    TLayoutArray<FOrderItem> Items;
+    Items.Reserve(MaxLayerSize);
+    TLayoutArray<int32> SouthOrders;
+    TLayoutArray<int32> Tree;
+
+    // Even rounds order by incoming neighbors, odd rounds by outgoing ones.
+    int64 BestCrossings =
+        CountAllCrossings(Flat, RankNodes, MaxRank, SouthOrders, Tree);
+    TLayoutArray<int32> BestOrder = Flat.Order;
+    const int32 MaxIterations = FMath::Max(1, Params.MaxIterations);
+    int32 Round = 0;
+    while (Round < MaxIterations && BestCrossings > 0 &&
+           FPlatformTime::Seconds() < DeadlineSeconds) {
+        if (Round % 2 == 0) {
+            RunSweep(Graph, Flat, RankNodes, Items, bCrossDetail, Label, Round, 1,
+                     MaxRank + 1, 1, ForwardPolicy, false, Params.bVirtualChains,
+                     SweepRanks, true);
+        } else {
+            RunSweep(Graph, Flat, RankNodes, Items, bCrossDetail, Label, Round,
+                     MaxRank - 1, -1, -1, BackwardPolicy, true, Params.bVirtualChains,
+                     SweepRanks, true);
+        }
+        OutSwaps += RunTranspose(Flat, RankNodes, SweepRanks, DeadlineSeconds);
+        ++Round;
+
+        // Keep strictly better orders so equal counts favor the earlier round.
+        const int64 Crossings =
+            CountAllCrossings(Flat, RankNodes, MaxRank, SouthOrders, Tree);
+        if (bDumpDetail) {
+            LAYOUT_LOG(Verbose,
+                       TEXT("Sugiyama[%s] MedianTranspose: round=%d crossings=%lld"),
+                       Label, Round - 1, Crossings);
+        }
+        if (Crossings < BestCrossings) {
+            BestCrossings = Crossings;
+            BestOrder = Flat.Order;
+        }
+    }
+
+    // Restore the best order into the rank lists and the Sugiyama nodes.
+    Flat.Order = BestOrder;
+    for (TLayoutArray<int32> &Layer : RankNodes) {
+        Layer.Sort([&](int32 A, int32 B) { return Flat.Order[A] < Flat.Order[B]; });
+    }
+    for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex) {
+        Graph.Nodes[NodeIndex].Order = Flat.Order[NodeIndex];
+    }
+
+    // Enforce min-len-zero ordering, then count what the placement will see.
+    ApplyMinLenZeroOrdering(Graph, RankNodes);
+    for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex) {
+        Flat.Order[NodeIndex] = Graph.Nodes[NodeIndex].Order;
+    }
+    OutCrossings = CountAllCrossings(Flat, RankNodes, MaxRank, SouthOrders, Tree);
+    if (bDumpDetail) {
+        LAYOUT_LOG(Verbose,
+                   TEXT("Sugiyama[%s] MedianTranspose: rounds=%d swaps=%d "
+                        "crossings=%lld"),
+                   Label, Round, OutSwaps, OutCrossings);
+    }
+    LogRankOrders(Label, TEXT("CrossingFinalOrder"), Graph, RankNodes);
+    return Round;
 }
 } // namespace GraphLayout
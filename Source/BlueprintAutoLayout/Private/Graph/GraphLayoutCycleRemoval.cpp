@@ -0,0 +1,489 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Sugiyama graph types and cycle removal declaration.
+#include "Graph/GraphLayoutSugiyama.h"
+
+// Logging for layout diagnostics.
+#include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutTrace.h"
+
+// Binary search for sorted adjacency patches.
+#include "Algo/BinarySearch.h"
+
+// Cycle removal for the Sugiyama layout pass.
+namespace GraphLayout
+{
+namespace
+{
+// DFS visit state used to detect back edges.
+enum class EVisitState : uint8
+{
+    Unvisited,
+    Visiting,
+    Done
+};
+
+// Each edge has two directed variants: the original and the reversed one.
+int32 MakeVariant(int32 EdgeIndex, bool bReversed)
+{
+    return EdgeIndex * 2 + (bReversed ? 1 : 0);
+}
+
+// Resolve effective endpoints and pins for a directed edge variant.
+int32 GetVariantSrc(const FSugiyamaEdge &Edge, bool bReversed)
+{
+    return bReversed ? Edge.Dst : Edge.Src;
+}
+
+int32 GetVariantDst(const FSugiyamaEdge &Edge, bool bReversed)
+{
+    return bReversed ? Edge.Src : Edge.Dst;
+}
+
+// Cycles are removed before long edges are split, so every edge owns its pin row.
+const FPinKey &GetVariantSrcPin(const FSugiyamaGraph &Graph, const FSugiyamaEdge &Edge,
+                                bool bReversed)
+{
+    const FSugiyamaEdgePins &Pins = Graph.EdgePins[Edge.PinsIndex];
+    return bReversed ? Pins.Dst : Pins.Src;
+}
+
+const FPinKey &GetVariantDstPin(const FSugiyamaGraph &Graph, const FSugiyamaEdge &Edge,
+                                bool bReversed)
+{
+    const FSugiyamaEdgePins &Pins = Graph.EdgePins[Edge.PinsIndex];
+    return bReversed ? Pins.Src : Pins.Dst;
+}
+
+// Rank every directed variant once so the DFS and back-edge selection only compare
+// integers. Both rankings follow the exact comparison rules of the full rebuild.
+void BuildVariantRanks(const FSugiyamaGraph &Graph,
+                       const TLayoutArray<int32> &KeyOrdinals,
+                       TLayoutArray<int32> &OutAdjacencyRank,
+                       TLayoutArray<int32> &OutBackEdgeRank)
+{
+    const int32 VariantCount = Graph.Edges.Num() * 2;
+    TLayoutArray<int32> Variants;
+    Variants.Reserve(VariantCount);
+    for (int32 Variant = 0; Variant < VariantCount; ++Variant) {
+        Variants.Add(Variant);
+    }
+
+    // Adjacency order: effective source pin, destination key, stable key, edge.
+    Variants.Sort([&](int32 A, int32 B) {
+        const FSugiyamaEdge &EdgeA = Graph.Edges[A / 2];
+        const FSugiyamaEdge &EdgeB = Graph.Edges[B / 2];
+        const bool bReversedA = (A & 1) != 0;
+        const bool bReversedB = (B & 1) != 0;
+        int32 Compare = ComparePinKey(GetVariantSrcPin(Graph, EdgeA, bReversedA),
+                                      GetVariantSrcPin(Graph, EdgeB, bReversedB));
+        if (Compare != 0) {
+            return Compare < 0;
+        }
+        const int32 DstOrdinalA = KeyOrdinals[GetVariantDst(EdgeA, bReversedA)];
+        const int32 DstOrdinalB = KeyOrdinals[GetVariantDst(EdgeB, bReversedB)];
+        if (DstOrdinalA != DstOrdinalB) {
+            return DstOrdinalA < DstOrdinalB;
+        }
+        if (EdgeA.StableKey != EdgeB.StableKey) {
+            return EdgeA.StableKey < EdgeB.StableKey;
+        }
+        return A < B;
+    });
+    OutAdjacencyRank.SetNumUninitialized(VariantCount);
+    for (int32 Index = 0; Index < VariantCount; ++Index) {
+        OutAdjacencyRank[Variants[Index]] = Index;
+    }
+
+    // Back-edge order: source key, source pin, destination key, destination pin, edge.
+    Variants.Sort([&](int32 A, int32 B) {
+        const FSugiyamaEdge &EdgeA = Graph.Edges[A / 2];
+        const FSugiyamaEdge &EdgeB = Graph.Edges[B / 2];
+        const bool bReversedA = (A & 1) != 0;
+        const bool bReversedB = (B & 1) != 0;
+        const int32 SrcOrdinalA = KeyOrdinals[GetVariantSrc(EdgeA, bReversedA)];
+        const int32 SrcOrdinalB = KeyOrdinals[GetVariantSrc(EdgeB, bReversedB)];
+        if (SrcOrdinalA != SrcOrdinalB) {
+            return SrcOrdinalA < SrcOrdinalB;
+        }
+        int32 Compare = ComparePinKey(GetVariantSrcPin(Graph, EdgeA, bReversedA),
+                                      GetVariantSrcPin(Graph, EdgeB, bReversedB));
+        if (Compare != 0) {
+            return Compare < 0;
+        }
+        const int32 DstOrdinalA = KeyOrdinals[GetVariantDst(EdgeA, bReversedA)];
+        const int32 DstOrdinalB = KeyOrdinals[GetVariantDst(EdgeB, bReversedB)];
+        if (DstOrdinalA != DstOrdinalB) {
+            return DstOrdinalA < DstOrdinalB;
+        }
+        Compare = ComparePinKey(GetVariantDstPin(Graph, EdgeA, bReversedA),
+                                GetVariantDstPin(Graph, EdgeB, bReversedB));
+        if (Compare != 0) {
+            return Compare < 0;
+        }
+        return A < B;
+    });
+    OutBackEdgeRank.SetNumUninitialized(VariantCount);
+    for (int32 Index = 0; Index < VariantCount; ++Index) {
+        OutBackEdgeRank[Variants[Index]] = Index;
+    }
+}
+
+// Report whether any strongly connected component has more than one node
+// (Tarjan's algorithm, iterative so large graphs do not recurse).
+bool HasCyclicComponent(const FSugiyamaGraph &Graph,
+                        const FLayoutIndexLists &OutEdges, int32 &OutCyclicNodes)
+{
+    const int32 NodeCount = Graph.Nodes.Num();
+    TLayoutArray<int32> VisitIndex;
+    TLayoutArray<int32> LowLink;
+    TLayoutArray<bool> bOnStack;
+    VisitIndex.Init(INDEX_NONE, NodeCount);
+    LowLink.Init(0, NodeCount);
+    bOnStack.Init(false, NodeCount);
+
+    // Tarjan's node stack plus an explicit call stack for the iterative walk.
+    struct FCallEntry
+    {
+        int32 NodeIndex = INDEX_NONE;
+        int32 NextEdge = 0;
+    };
+    TLayoutArray<int32> SccStack;
+    TLayoutArray<FCallEntry> CallStack;
+    int32 NextIndex = 0;
+    OutCyclicNodes = 0;
+
+    for (int32 Root = 0; Root < NodeCount; ++Root) {
+        if (VisitIndex[Root] != INDEX_NONE) {
+            continue;
+        }
+        VisitIndex[Root] = LowLink[Root] = NextIndex++;
+        SccStack.Add(Root);
+        bOnStack[Root] = true;
+        CallStack.Add({Root, 0});
+
+        while (!CallStack.IsEmpty()) {
+            FCallEntry &Entry = CallStack.Last();
+            const int32 NodeIndex = Entry.NodeIndex;
+
+            // Descend into the next unvisited successor.
+            if (Entry.NextEdge < OutEdges[NodeIndex].Num()) {
+                const FSugiyamaEdge &Edge =
+                    Graph.Edges[OutEdges[NodeIndex][Entry.NextEdge++]];
+                const int32 NextNode = GetVariantDst(Edge, Edge.bReversed);
+                if (VisitIndex[NextNode] == INDEX_NONE) {
+                    VisitIndex[NextNode] = LowLink[NextNode] = NextIndex++;
+                    SccStack.Add(NextNode);
+                    bOnStack[NextNode] = true;
+                    CallStack.Add({NextNode, 0});
+                } else if (bOnStack[NextNode]) {
+                    LowLink[NodeIndex] =
+                        FMath::Min(LowLink[NodeIndex], VisitIndex[NextNode]);
+                }
+                continue;
+            }
+
+            // Pop a finished component root and measure its size.
+            if (LowLink[NodeIndex] == VisitIndex[NodeIndex]) {
+                int32 ComponentSize = 0;
+                int32 Member = INDEX_NONE;
+                do {
+                    Member = SccStack.Pop(EAllowShrinking::No);
+                    bOnStack[Member] = false;
+                    ++ComponentSize;
+                } while (Member != NodeIndex);
+                if (ComponentSize > 1) {
+                    OutCyclicNodes += ComponentSize;
+                }
+            }
+
+            // Return to the caller and propagate the low link.
+            CallStack.Pop(EAllowShrinking::No);
+            if (!CallStack.IsEmpty()) {
+                const int32 Parent = CallStack.Last().NodeIndex;
+                LowLink[Parent] = FMath::Min(LowLink[Parent], LowLink[NodeIndex]);
+            }
+        }
+    }
+    return OutCyclicNodes > 0;
+}
+
+// Incremental DFS state for cycle breaking. The DFS forest from the full traversal
+// is kept, and flipping a back edge only re-runs the subtree rooted at its target.
+// That subtree holds the same node set before and after the flip, so every other
+// back edge, discovery index, and subtree range stays valid.
+struct FCycleBreaker
+{
+    FCycleBreaker(FSugiyamaGraph &InGraph, const TLayoutArray<int32> &InKeyOrdinals)
+        : Graph(InGraph), KeyOrdinals(InKeyOrdinals)
+    {
+    }
+
+    // Heap entry for a candidate back edge; stale entries are skipped on pop.
+    struct FCandidate
+    {
+        int32 Rank = 0;
+        int32 EdgeIndex = INDEX_NONE;
+        int32 Stamp = 0;
+    };
+
+    // Iterative DFS stack entry tracking the next edge to scan.
+    struct FStackEntry
+    {
+        int32 NodeIndex = INDEX_NONE;
+        int32 NextEdge = 0;
+    };
+
+    // Build sorted effective adjacency once from the precomputed variant ranks.
+    void BuildAdjacency()
+    {
+        BuildVariantRanks(Graph, KeyOrdinals, AdjacencyRank, BackEdgeRank);
+        OutEdges.SetNum(Graph.Nodes.Num());
+
+        // Appending in global adjacency order yields sorted per-node lists.
+        TLayoutArray<int32> Variants;
+        Variants.SetNumUninitialized(AdjacencyRank.Num());
+        for (int32 Variant = 0; Variant < AdjacencyRank.Num(); ++Variant) {
+            Variants[AdjacencyRank[Variant]] = Variant;
+        }
+        for (int32 Variant : Variants) {
+            const int32 EdgeIndex = Variant / 2;
+            const FSugiyamaEdge &Edge = Graph.Edges[EdgeIndex];
+            if (Edge.bReversed != ((Variant & 1) != 0)) {
+                continue;
+            }
+            const int32 Src = GetVariantSrc(Edge, Edge.bReversed);
+            if (Src == GetVariantDst(Edge, Edge.bReversed)) {
+                continue;
+            }
+            OutEdges[Src].Add(EdgeIndex);
+        }
+    }
+
+    // Run the full DFS forest once, starting from nodes in key order.
+    void RunFullTraversal(const TLayoutArray<int32> &NodeOrder)
+    {
+        const int32 NodeCount = Graph.Nodes.Num();
+        VisitState.Init(EVisitState::Unvisited, NodeCount);
+        Parent.Init(INDEX_NONE, NodeCount);
+        PreIndex.Init(INDEX_NONE, NodeCount);
+        SubtreeEnd.Init(0, NodeCount);
+        NodeAtPre.SetNumUninitialized(NodeCount);
+        bIsBackEdge.Init(false, Graph.Edges.Num());
+        Stamps.Init(0, Graph.Edges.Num());
+
+        int32 NextPre = 0;
+        for (int32 StartNode : NodeOrder) {
+            if (VisitState[StartNode] == EVisitState::Unvisited) {
+                NextPre = VisitSubtree(StartNode, NextPre);
+            }
+        }
+    }
+
+    // DFS from Root assigning discovery indices from FirstPre; returns the next index.
+    int32 VisitSubtree(int32 Root, int32 FirstPre)
+    {
+        int32 NextPre = FirstPre;
+        Stack.Reset();
+        Stack.Add({Root, 0});
+        VisitState[Root] = EVisitState::Visiting;
+        PreIndex[Root] = NextPre;
+        NodeAtPre[NextPre++] = Root;
+
+        while (!Stack.IsEmpty()) {
+            FStackEntry &Entry = Stack.Last();
+            if (Entry.NextEdge >= OutEdges[Entry.NodeIndex].Num()) {
+                VisitState[Entry.NodeIndex] = EVisitState::Done;
+                SubtreeEnd[Entry.NodeIndex] = NextPre;
+                Stack.Pop(EAllowShrinking::No);
+                continue;
+            }
+
+            // Advance to the next outgoing edge.
+            const int32 CurrentNode = Entry.NodeIndex;
+            const int32 EdgeIndex = OutEdges[CurrentNode][Entry.NextEdge++];
+            const FSugiyamaEdge &Edge = Graph.Edges[EdgeIndex];
+            const int32 NextNode = GetVariantDst(Edge, Edge.bReversed);
+
+            // Traverse to unvisited nodes or record back edges.
+            if (VisitState[NextNode] == EVisitState::Unvisited) {
+                VisitState[NextNode] = EVisitState::Visiting;
+                Parent[NextNode] = CurrentNode;
+                PreIndex[NextNode] = NextPre;
+                NodeAtPre[NextPre++] = NextNode;
+                Stack.Add({NextNode, 0});
+            } else if (VisitState[NextNode] == EVisitState::Visiting) {
+                MarkBackEdge(EdgeIndex);
+            }
+        }
+        return NextPre;
+    }
+
+    // Record a back edge and queue it as a reversal candidate.
+    void MarkBackEdge(int32 EdgeIndex)
+    {
+        const FSugiyamaEdge &Edge = Graph.Edges[EdgeIndex];
+        bIsBackEdge[EdgeIndex] = true;
+        ++BackEdgeCount;
+        FCandidate Candidate;
+        Candidate.Rank = BackEdgeRank[MakeVariant(EdgeIndex, Edge.bReversed)];
+        Candidate.EdgeIndex = EdgeIndex;
+        Candidate.Stamp = ++Stamps[EdgeIndex];
+        Candidates.HeapPush(Candidate, FCandidateLess());
+    }
+
+    // Drop the back-edge flag; any heap entry for it becomes stale.
+    void ClearBackEdge(int32 EdgeIndex)
+    {
+        if (bIsBackEdge[EdgeIndex]) {
+            bIsBackEdge[EdgeIndex] = false;
+            --BackEdgeCount;
+        }
+    }
+
+    // Pop the smallest live back edge by the deterministic tuple order.
+    int32 PopBestBackEdge()
+    {
+        while (!Candidates.IsEmpty()) {
+            FCandidate Top;
+            Candidates.HeapPop(Top, FCandidateLess(), EAllowShrinking::No);
+            if (bIsBackEdge[Top.EdgeIndex] && Stamps[Top.EdgeIndex] == Top.Stamp) {
+                return Top.EdgeIndex;
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    // Flip a back edge and re-run the DFS subtree rooted at its effective target.
+    void ReverseBackEdge(int32 EdgeIndex)
+    {
+        FSugiyamaEdge &Edge = Graph.Edges[EdgeIndex];
+        const int32 OldSrc = GetVariantSrc(Edge, Edge.bReversed);
+        const int32 SubtreeRoot = GetVariantDst(Edge, Edge.bReversed);
+        const int32 FirstPre = PreIndex[SubtreeRoot];
+        const int32 EndPre = SubtreeEnd[SubtreeRoot];
+
+        // Forget back edges discovered inside the subtree; they are rediscovered.
+        for (int32 Pre = FirstPre; Pre < EndPre; ++Pre) {
+            for (int32 SubtreeEdge : OutEdges[NodeAtPre[Pre]]) {
+                ClearBackEdge(SubtreeEdge);
+            }
+        }
+
+        // Move the edge into its new source list at the sorted position.
+        OutEdges[OldSrc].Remove(EdgeIndex);
+        Edge.bReversed = !Edge.bReversed;
+        const int32 NewRank = AdjacencyRank[MakeVariant(EdgeIndex, Edge.bReversed)];
+        TLayoutArray<int32> &TargetList = OutEdges[SubtreeRoot];
+        const int32 InsertIndex =
+            Algo::LowerBoundBy(TargetList, NewRank, [&](int32 ListEdge) {
+                const bool bListReversed = Graph.Edges[ListEdge].bReversed;
+                return AdjacencyRank[MakeVariant(ListEdge, bListReversed)];
+            });
+        TargetList.Insert(EdgeIndex, InsertIndex);
+
+        // Restore the DFS state seen when the subtree root was first discovered.
+        for (int32 Ancestor = Parent[SubtreeRoot]; Ancestor != INDEX_NONE;
+             Ancestor = Parent[Ancestor]) {
+            VisitState[Ancestor] = EVisitState::Visiting;
+        }
+        for (int32 Pre = FirstPre; Pre < EndPre; ++Pre) {
+            VisitState[NodeAtPre[Pre]] = EVisitState::Unvisited;
+        }
+
+        // Re-run only the affected subtree, reusing its discovery index range.
+        VisitSubtree(SubtreeRoot, FirstPre);
+
+        // Ancestors are finished again once the subtree has been re-walked.
+        for (int32 Ancestor = Parent[SubtreeRoot]; Ancestor != INDEX_NONE;
+             Ancestor = Parent[Ancestor]) {
+            VisitState[Ancestor] = EVisitState::Done;
+        }
+    }
+
+    // Min-heap predicate over precomputed back-edge ranks.
+    struct FCandidateLess
+    {
+        bool operator()(const FCandidate &A, const FCandidate &B) const
+        {
+            return A.Rank < B.Rank;
+        }
+    };
+
+    FSugiyamaGraph &Graph;
+    const TLayoutArray<int32> &KeyOrdinals;
+    TLayoutArray<int32> AdjacencyRank;
+    TLayoutArray<int32> BackEdgeRank;
+    FLayoutIndexLists OutEdges;
+    TLayoutArray<EVisitState> VisitState;
+    TLayoutArray<int32> Parent;
+    TLayoutArray<int32> PreIndex;
+    TLayoutArray<int32> SubtreeEnd;
+    TLayoutArray<int32> NodeAtPre;
+    TLayoutArray<bool> bIsBackEdge;
+    TLayoutArray<int32> Stamps;
+    TLayoutArray<FCandidate> Candidates;
+    TLayoutArray<FStackEntry> Stack;
+    int32 BackEdgeCount = 0;
+};
+} // namespace
+
+// Find back edges via DFS and flip the best candidate until the graph is a DAG.
+void RemoveCycles(FSugiyamaGraph &Graph, const TCHAR *Label)
+{
+    if (Graph.Nodes.Num() < 2 || Graph.Edges.IsEmpty()) {
+        return;
+    }
+
+    // Log the start of cycle removal for diagnostics.
+    LAYOUT_LOG(Verbose, TEXT("Sugiyama[%s] RemoveCycles: start nodes=%d edges=%d"),
+               Label, Graph.Nodes.Num(), Graph.Edges.Num());
+
+    // Rank node keys once; the key order doubles as the DFS start order.
+    TLayoutArray<int32> KeyOrdinals;
+    TLayoutArray<int32> NodeOrder;
+    BuildNodeKeyOrdinals(Graph, KeyOrdinals, NodeOrder);
+
+    // Build effective adjacency once; later reversals patch it in place.
+    FCycleBreaker Breaker(Graph, KeyOrdinals);
+    Breaker.BuildAdjacency();
+
+    // Skip the DFS entirely when no strongly connected component has a cycle.
+    int32 CyclicNodes = 0;
+    if (!HasCyclicComponent(Graph, Breaker.OutEdges, CyclicNodes)) {
+        LAYOUT_LOG(Verbose, TEXT("Sugiyama[%s] RemoveCycles: done (acyclic)"), Label);
+        return;
+    }
+    LAYOUT_LOG(Verbose, TEXT("Sugiyama[%s] RemoveCycles: cyclicNodes=%d"), Label,
+               CyclicNodes);
+
+    // Discover all back edges with one full traversal.
+    Breaker.RunFullTraversal(NodeOrder);
+
+    // Repeat until no back edges remain.
+    for (;;) {
+        const int32 BestEdge = Breaker.PopBestBackEdge();
+
+        // Stop once the graph is acyclic.
+        if (BestEdge == INDEX_NONE) {
+            LAYOUT_LOG(Verbose, TEXT("Sugiyama[%s] RemoveCycles: done"), Label);
+            break;
+        }
+
+        // Log the number of back edges before reversing the chosen one.
+        LAYOUT_LOG(Verbose, TEXT("Sugiyama[%s] RemoveCycles: backEdges=%d"), Label,
+                   Breaker.BackEdgeCount);
+        const FSugiyamaEdge &ChosenEdge = Graph.Edges[BestEdge];
+        const int32 EffectiveSrc = GetVariantSrc(ChosenEdge, ChosenEdge.bReversed);
+        const int32 EffectiveDst = GetVariantDst(ChosenEdge, ChosenEdge.bReversed);
+        LAYOUT_LOG(Verbose,
+                   TEXT("Sugiyama[%s] RemoveCycles: reverse edge %s -> %s stable=%s"),
+                   Label, *BuildNodeKeyString(Graph.Nodes[EffectiveSrc].Key),
+                   *BuildNodeKeyString(Graph.Nodes[EffectiveDst].Key),
+                   *BuildEdgeKeyString(ChosenEdge.StableKey));
+
+        // Flip the selected edge and refresh only the affected DFS subtree.
+        Breaker.ReverseBackEdge(BestEdge);
+    }
+}
+} // namespace GraphLayout
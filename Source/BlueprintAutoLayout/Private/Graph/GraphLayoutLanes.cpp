@@ -0,0 +1,469 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Lane coarsening interface.
+#include "Graph/GraphLayoutLanes.h"
+
+// Sugiyama passes and the constraint solver used to compose block ranks.
+#include "Graph/GraphLayoutArena.h"
+#include "Graph/GraphLayoutLayerConstraints.h"
+#include "Graph/GraphLayoutSugiyama.h"
+
+// Logging, stats, and parallel dispatch of in-lane passes.
+#include "Async/ParallelFor.h"
+#include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutStats.h"
+#include "BlueprintAutoLayoutTrace.h"
+
+// Lane/junction coarsening implementation.
+namespace GraphLayout
+{
+namespace
+{
+// A junction or a lane of the lane graph. Members are node indices in ascending
+// order; data nodes join the block of the nearest exec node.
+struct FLaneBlock
+{
+    // Junction node, or the first exec member of a lane; its key names the block.
+    int32 AnchorNode = INDEX_NONE;
+    bool bIsLane = false;
+
+    // Whether the lane leaves a junction and reaches one (SPEC 2.3.3).
+    bool bHasStart = false;
+    bool bHasEnd = false;
+    TLayoutArray<int32> Members;
+};
+
+// Lane graph edges keep each junction's real pin; lanes expose a single pin.
+const FName &GetLanePinName()
+{
+    static const FName LanePinName(TEXT("Lane"));
+    return LanePinName;
+}
+
+// Rank node keys so blocks and nodes tie-break as in the flat pipeline.
+void BuildKeyOrder(TConstArrayView<FLayoutNode> Nodes, TLayoutArray<int32> &OutKeyOrder,
+                   TLayoutArray<int32> &OutKeyOrdinals)
+{
+    OutKeyOrder.Reset(Nodes.Num());
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index) {
+        OutKeyOrder.Add(Index);
+    }
+    OutKeyOrder.Sort([&Nodes](int32 A, int32 B) {
+        const int32 Compare = CompareNodeKey(Nodes[A].Key, Nodes[B].Key);
+        return Compare != 0 ? Compare < 0 : A < B;
+    });
+    OutKeyOrdinals.SetNumUninitialized(Nodes.Num());
+    for (int32 Position = 0; Position < OutKeyOrder.Num(); ++Position) {
+        OutKeyOrdinals[OutKeyOrder[Position]] = Position;
+    }
+}
+
+// Split the component into junction and lane blocks, then attach data nodes.
+// Returns false when no node has exec pins.
+bool BuildLaneBlocks(TConstArrayView<FLayoutNode> Nodes,
+                     TConstArrayView<FLayoutEdge> Edges,
+                     const TLayoutArray<int32> &KeyOrder,
+                     TLayoutArray<FLaneBlock> &OutBlocks,
+                     TLayoutArray<int32> &OutBlockOfNode)
+{
+    const int32 NodeCount = Nodes.Num();
+
+    // Count exec degrees and list exec outputs and data links per node. Edges are
+    // sorted by stable key, so each node's exec outputs are in pin order.
+    TLayoutArray<int32> ExecInDegree;
+    ExecInDegree.Init(0, NodeCount);
+    FLayoutIndexLists ExecOutEdges;
+    ExecOutEdges.SetNum(NodeCount);
+    FLayoutIndexLists DataEdges;
+    DataEdges.SetNum(NodeCount);
+    for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex) {
+        const FLayoutEdge &Edge = Edges[EdgeIndex];
+        if (Edge.Src == Edge.Dst) {
+            continue;
+        }
+        if (Edge.Kind == EEdgeKind::Exec) {
+            ++ExecInDegree[Edge.Dst];
+            ExecOutEdges[Edge.Src].Add(EdgeIndex);
+        } else {
+            DataEdges[Edge.Src].Add(EdgeIndex);
+            DataEdges[Edge.Dst].Add(EdgeIndex);
+        }
+    }
+
+    // A junction is an exec node whose exec degree is not (1, 1) (SPEC 2.3.1).
+    TLayoutArray<bool> bJunction;
+    bJunction.Init(false, NodeCount);
+    bool bAnyExec = false;
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        if (!Nodes[NodeIndex].bHasExecPins) {
+            continue;
+        }
+        bAnyExec = true;
+        bJunction[NodeIndex] =
+            ExecInDegree[NodeIndex] != 1 || ExecOutEdges[NodeIndex].Num() != 1;
+    }
+    if (!bAnyExec) {
+        return false;
+    }
+
+    // Every block holds at least one node, so reserving keeps block storage stable.
+    OutBlocks.Reset(NodeCount);
+    OutBlockOfNode.Init(INDEX_NONE, NodeCount);
+    auto AddBlock = [&](int32 AnchorNode, bool bIsLane) {
+        const int32 BlockIndex = OutBlocks.AddDefaulted();
+        OutBlocks[BlockIndex].AnchorNode = AnchorNode;
+        OutBlocks[BlockIndex].bIsLane = bIsLane;
+        return BlockIndex;
+    };
+    auto AssignNode = [&](int32 NodeIndex, int32 BlockIndex) {
+        OutBlockOfNode[NodeIndex] = BlockIndex;
+        OutBlocks[BlockIndex].Members.Add(NodeIndex);
+    };
+
+    // Follow (1, 1) exec nodes until a junction, a node without exec pins, or an
+    // already visited member is reached.
+    auto WalkLane = [&](int32 FirstNode, int32 BlockIndex) {
+        int32 Current = FirstNode;
+        while (Nodes[Current].bHasExecPins && !bJunction[Current] &&
+               OutBlockOfNode[Current] == INDEX_NONE) {
+            AssignNode(Current, BlockIndex);
+            Current = Edges[ExecOutEdges[Current][0]].Dst;
+        }
+        OutBlocks[BlockIndex].bHasEnd = bJunction[Current];
+    };
+
+    // Junctions in key order, then one lane per exec output that reaches a
+    // non-junction; direct junction links form no lane (SPEC 2.3.3).
+    for (int32 NodeIndex : KeyOrder) {
+        if (bJunction[NodeIndex]) {
+            AssignNode(NodeIndex, AddBlock(NodeIndex, false));
+        }
+    }
+    for (int32 NodeIndex : KeyOrder) {
+        if (!bJunction[NodeIndex]) {
+            continue;
+        }
+        for (int32 EdgeIndex : ExecOutEdges[NodeIndex]) {
+            const int32 FirstNode = Edges[EdgeIndex].Dst;
+            if (!Nodes[FirstNode].bHasExecPins || bJunction[FirstNode] ||
+                OutBlockOfNode[FirstNode] != INDEX_NONE) {
+                continue;
+            }
+            const int32 BlockIndex = AddBlock(FirstNode, true);
+            OutBlocks[BlockIndex].bHasStart = true;
+            WalkLane(FirstNode, BlockIndex);
+        }
+    }
+
+    // Exec cycles without a junction become one orphan lane anchored at their
+    // smallest key.
+    for (int32 NodeIndex : KeyOrder) {
+        if (Nodes[NodeIndex].bHasExecPins && OutBlockOfNode[NodeIndex] == INDEX_NONE) {
+            WalkLane(NodeIndex, AddBlock(NodeIndex, true));
+        }
+    }
+
+    // Data nodes join the block of the nearest exec node, searching breadth-first
+    // from every exec node in key order.
+    TLayoutArray<int32> Queue;
+    Queue.Reserve(NodeCount);
+    for (int32 NodeIndex : KeyOrder) {
+        if (OutBlockOfNode[NodeIndex] != INDEX_NONE) {
+            Queue.Add(NodeIndex);
+        }
+    }
+    for (int32 Head = 0; Head < Queue.Num(); ++Head) {
+        const int32 NodeIndex = Queue[Head];
+        for (int32 EdgeIndex : DataEdges[NodeIndex]) {
+            const FLayoutEdge &Edge = Edges[EdgeIndex];
+            const int32 Other = Edge.Src == NodeIndex ? Edge.Dst : Edge.Src;
+            if (OutBlockOfNode[Other] == INDEX_NONE) {
+                AssignNode(Other, OutBlockOfNode[NodeIndex]);
+                Queue.Add(Other);
+            }
+        }
+    }
+
+    // Nodes of a disconnected input keep blocks of their own.
+    for (int32 NodeIndex : KeyOrder) {
+        if (OutBlockOfNode[NodeIndex] == INDEX_NONE) {
+            AssignNode(NodeIndex, AddBlock(NodeIndex, false));
+        }
+    }
+    for (FLaneBlock &Block : OutBlocks) {
+        Block.Members.Sort();
+    }
+    return true;
+}
+
+// Build the lane graph: one node per block and one exec edge per link between
+// blocks. Lanes have exec degree (1, 1), or 0 on a side without a junction.
+void BuildLaneGraph(TConstArrayView<FLayoutNode> Nodes,
+                    TConstArrayView<FLayoutEdge> Edges,
+                    const TLayoutArray<FLaneBlock> &Blocks,
+                    const TLayoutArray<int32> &BlockOfNode, FSugiyamaGraph &OutGraph)
+{
+    OutGraph.Nodes.Reset(Blocks.Num());
+    OutGraph.Edges.Reset();
+    OutGraph.EdgePins.Reset();
+    OutGraph.Chains.Reset();
+    for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex) {
+        const FLaneBlock &Block = Blocks[BlockIndex];
+        const FLayoutNode &Anchor = Nodes[Block.AnchorNode];
+        FSugiyamaNode Node;
+        Node.Id = BlockIndex;
+        Node.Key = Anchor.Key;
+        Node.bHasExecPins = Anchor.bHasExecPins;
+        if (Block.bIsLane) {
+            Node.ExecInputPinCount = Block.bHasStart ? 1 : 0;
+            Node.ExecOutputPinCount = Block.bHasEnd ? 1 : 0;
+            Node.InputPinCount = Node.ExecInputPinCount;
+            Node.OutputPinCount = Node.ExecOutputPinCount;
+        } else {
+            Node.ExecInputPinCount = FMath::Max(0, Anchor.ExecInputPinCount);
+            Node.ExecOutputPinCount = FMath::Max(0, Anchor.ExecOutputPinCount);
+            Node.InputPinCount = FMath::Max(0, Anchor.InputPinCount);
+            Node.OutputPinCount = FMath::Max(0, Anchor.OutputPinCount);
+        }
+        Node.Size = FVector2f(1.0f, 1.0f);
+        Node.SourceIndex = BlockIndex;
+        OutGraph.Nodes.Add(MoveTemp(Node));
+    }
+
+    // Exec links between blocks keep their stable keys, and so their order.
+    for (const FLayoutEdge &Edge : Edges) {
+        if (Edge.Kind != EEdgeKind::Exec) {
+            continue;
+        }
+        const int32 SrcBlock = BlockOfNode[Edge.Src];
+        const int32 DstBlock = BlockOfNode[Edge.Dst];
+        if (SrcBlock == DstBlock) {
+            continue;
+        }
+        const bool bSrcLane = Blocks[SrcBlock].bIsLane;
+        const bool bDstLane = Blocks[DstBlock].bIsLane;
+        FSugiyamaEdge LaneEdge;
+        LaneEdge.Src = SrcBlock;
+        LaneEdge.Dst = DstBlock;
+        LaneEdge.SrcPinIndex = bSrcLane ? 0 : FMath::Max(0, Edge.SrcPinIndex);
+        LaneEdge.DstPinIndex = bDstLane ? 0 : FMath::Max(0, Edge.DstPinIndex);
+        LaneEdge.PinsIndex = OutGraph.EdgePins.Add(
+            {MakePinKey(OutGraph.Nodes[SrcBlock].Key, EPinDirection::Output,
+                        bSrcLane ? GetLanePinName() : Edge.SrcPinName,
+                        LaneEdge.SrcPinIndex),
+             MakePinKey(OutGraph.Nodes[DstBlock].Key, EPinDirection::Input,
+                        bDstLane ? GetLanePinName() : Edge.DstPinName,
+                        LaneEdge.DstPinIndex)});
+        LaneEdge.Kind = EEdgeKind::Exec;
+        LaneEdge.StableKey = Edge.StableKey;
+        OutGraph.Edges.Add(MoveTemp(LaneEdge));
+    }
+}
+
+// Layer and order one block's members on their own. Runs on worker threads, so
+// it opens its own arena mark and only writes the slots of its own members.
+void LayoutBlockMembers(TConstArrayView<FLayoutNode> Nodes,
+                        TConstArrayView<FLayoutEdge> Edges, const FLaneBlock &Block,
+                        const TLayoutArray<int32> &BlockEdges,
+                        const TLayoutArray<int32> &MemberSlot,
+                        const FLaneLayoutParams &Params,
+                        TLayoutArray<int32> &LocalRanks,
+                        TLayoutArray<int32> &LocalOrders, FLayoutStats &OutStats)
+{
+    FMemMark BlockMark(FMemStack::Get());
+
+    // Members are listed by node index, so their slots keep the id order.
+    TLayoutArray<FLayoutNode> BlockNodes;
+    BlockNodes.Reserve(Block.Members.Num());
+    for (int32 NodeIndex : Block.Members) {
+        BlockNodes.Add(Nodes[NodeIndex]);
+    }
+    TLayoutArray<FLayoutEdge> BlockEdgeList;
+    BlockEdgeList.Reserve(BlockEdges.Num());
+    for (int32 EdgeIndex : BlockEdges) {
+        FLayoutEdge Edge = Edges[EdgeIndex];
+        Edge.Src = MemberSlot[Edge.Src];
+        Edge.Dst = MemberSlot[Edge.Dst];
+        BlockEdgeList.Add(MoveTemp(Edge));
+    }
+
+    FSugiyamaGraph Graph;
+    BuildSugiyamaGraph(BlockNodes, BlockEdgeList, Graph);
+    RunSugiyama(Graph, Params.Crossing, false, TEXT("Lane"),
+                Params.VariableGetMinLength, OutStats);
+
+    // Normalize member ranks so the block starts at local rank 0 (SPEC 4.2).
+    int32 MinRank = MAX_int32;
+    for (const FSugiyamaNode &Node : Graph.Nodes) {
+        if (!Node.bIsDummy) {
+            MinRank = FMath::Min(MinRank, Node.Rank);
+        }
+    }
+    for (const FSugiyamaNode &Node : Graph.Nodes) {
+        if (Node.bIsDummy || !Block.Members.IsValidIndex(Node.SourceIndex)) {
+            continue;
+        }
+        const int32 NodeIndex = Block.Members[Node.SourceIndex];
+        LocalRanks[NodeIndex] = Node.Rank - MinRank;
+        LocalOrders[NodeIndex] = Node.Order;
+    }
+}
+} // namespace
+
+// Coarsen into lanes and junctions, order the lane graph, lay out members per
+// block, then compose global ranks and orders (SPEC 2-4).
+bool AssignCoarsenedRankOrders(TArrayView<FLayoutNode> Nodes,
+                               TConstArrayView<FLayoutEdge> Edges,
+                               const FLaneLayoutParams &Params, FLayoutStats &Stats)
+{
+    BLUEPRINTAUTOLAYOUT_SCOPE(STAT_BlueprintAutoLayout_CoarsenExecLanes);
+    const int32 NodeCount = Nodes.Num();
+    TLayoutArray<int32> KeyOrder;
+    TLayoutArray<int32> KeyOrdinals;
+    BuildKeyOrder(Nodes, KeyOrder, KeyOrdinals);
+
+    // Split the component into blocks; pure data components stay flat.
+    TLayoutArray<FLaneBlock> Blocks;
+    TLayoutArray<int32> BlockOfNode;
+    if (!BuildLaneBlocks(Nodes, Edges, KeyOrder, Blocks, BlockOfNode)) {
+        return false;
+    }
+
+    // Index members within their block and group the edges inside each block.
+    TLayoutArray<int32> MemberSlot;
+    MemberSlot.SetNumUninitialized(NodeCount);
+    for (const FLaneBlock &Block : Blocks) {
+        for (int32 Slot = 0; Slot < Block.Members.Num(); ++Slot) {
+            MemberSlot[Block.Members[Slot]] = Slot;
+        }
+    }
+    FLayoutIndexLists BlockEdges;
+    BlockEdges.SetNum(Blocks.Num());
+    for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex) {
+        const FLayoutEdge &Edge = Edges[EdgeIndex];
+        if (Edge.Src != Edge.Dst && BlockOfNode[Edge.Src] == BlockOfNode[Edge.Dst]) {
+            BlockEdges[BlockOfNode[Edge.Src]].Add(EdgeIndex);
+        }
+    }
+
+    // Order the lane graph; each block's rank and order come from its node.
+    FSugiyamaGraph LaneGraph;
+    BuildLaneGraph(Nodes, Edges, Blocks, BlockOfNode, LaneGraph);
+    FLayoutStats LaneGraphStats;
+    const int32 MaxColumn =
+        RunSugiyama(LaneGraph, Params.Crossing, false, TEXT("LaneGraph"),
+                    Params.VariableGetMinLength, LaneGraphStats);
+    Stats.Accumulate(LaneGraphStats);
+
+    // Lay out block members in parallel. Every block writes only its own member
+    // slots and stats; verbose traces keep the passes serial so dumps stay ordered.
+    TLayoutArray<int32> LocalRanks;
+    LocalRanks.Init(0, NodeCount);
+    TLayoutArray<int32> LocalOrders;
+    LocalOrders.Init(0, NodeCount);
+    TLayoutArray<FLayoutStats> BlockStats;
+    BlockStats.SetNum(Blocks.Num());
+    const bool bSerial = LAYOUT_TRACE_ACTIVE(Verbose);
+    ParallelFor(
+        Blocks.Num(),
+        [&](int32 BlockIndex) {
+            if (Blocks[BlockIndex].Members.Num() < 2) {
+                return;
+            }
+            LayoutBlockMembers(Nodes, Edges, Blocks[BlockIndex], BlockEdges[BlockIndex],
+                               MemberSlot, Params, LocalRanks, LocalOrders,
+                               BlockStats[BlockIndex]);
+        },
+        bSerial ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+    for (const FLayoutStats &BlockStat : BlockStats) {
+        Stats.Accumulate(BlockStat);
+    }
+
+    // Compose column bases without reordering blocks (SPEC 4.3): columns keep
+    // their order, and every forward link between blocks keeps a one-rank gap
+    // between its endpoints. Links within a column or backwards are not enforced.
+    const int32 ColumnCount = MaxColumn + 1;
+    TLayoutArray<FLayerConstraint> Constraints;
+    Constraints.Reserve(ColumnCount + Edges.Num());
+    auto AddConstraint = [&Constraints](int32 SrcColumn, int32 DstColumn,
+                                        int32 Weight) {
+        FLayerConstraint Constraint;
+        Constraint.Src = SrcColumn;
+        Constraint.Dst = DstColumn;
+        Constraint.Weight = Weight;
+        Constraints.Add(Constraint);
+    };
+    for (int32 Column = 0; Column + 1 < ColumnCount; ++Column) {
+        AddConstraint(Column, Column + 1, 1);
+    }
+    for (const FLayoutEdge &Edge : Edges) {
+        const int32 SrcColumn = LaneGraph.Nodes[BlockOfNode[Edge.Src]].Rank;
+        const int32 DstColumn = LaneGraph.Nodes[BlockOfNode[Edge.Dst]].Rank;
+        if (SrcColumn >= DstColumn) {
+            continue;
+        }
+        const int32 Weight = LocalRanks[Edge.Src] - LocalRanks[Edge.Dst] + 1;
+        AddConstraint(SrcColumn, DstColumn, Weight);
+    }
+    FLayerConstraintSystem System;
+    BuildLayerConstraintSystem(ColumnCount, MoveTemp(Constraints), System);
+    TLayoutArray<int32> ColumnBase;
+    ColumnBase.Init(0, ColumnCount);
+    const FLayerConstraintStats SolveStats = SolveLayerLowerBounds(System, ColumnBase);
+    Stats.ConstraintVisits += SolveStats.Visits;
+    Stats.ConstraintRelaxations += SolveStats.Relaxations;
+
+    // Global rank is the block's column base plus the member's local rank.
+    int32 MaxRank = 0;
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        const int32 Column = LaneGraph.Nodes[BlockOfNode[NodeIndex]].Rank;
+        Nodes[NodeIndex].GlobalRank = ColumnBase[Column] + LocalRanks[NodeIndex];
+        MaxRank = FMath::Max(MaxRank, Nodes[NodeIndex].GlobalRank);
+    }
+
+    // Concatenate blocks per rank by (blockOrder, blockId), then members by
+    // (localOrder, NodeKey) (SPEC 4.6).
+    TLayoutArray<int32> RankOrder(KeyOrder);
+    RankOrder.Sort([&](int32 A, int32 B) {
+        if (Nodes[A].GlobalRank != Nodes[B].GlobalRank) {
+            return Nodes[A].GlobalRank < Nodes[B].GlobalRank;
+        }
+        const FLaneBlock &BlockA = Blocks[BlockOfNode[A]];
+        const FLaneBlock &BlockB = Blocks[BlockOfNode[B]];
+        const int32 BlockOrderA = LaneGraph.Nodes[BlockOfNode[A]].Order;
+        const int32 BlockOrderB = LaneGraph.Nodes[BlockOfNode[B]].Order;
+        if (BlockOrderA != BlockOrderB) {
+            return BlockOrderA < BlockOrderB;
+        }
+        if (BlockA.AnchorNode != BlockB.AnchorNode) {
+            return KeyOrdinals[BlockA.AnchorNode] < KeyOrdinals[BlockB.AnchorNode];
+        }
+        if (LocalOrders[A] != LocalOrders[B]) {
+            return LocalOrders[A] < LocalOrders[B];
+        }
+        return KeyOrdinals[A] < KeyOrdinals[B];
+    });
+    int32 PrevRank = INDEX_NONE;
+    int32 NextOrder = 0;
+    for (int32 NodeIndex : RankOrder) {
+        if (Nodes[NodeIndex].GlobalRank != PrevRank) {
+            PrevRank = Nodes[NodeIndex].GlobalRank;
+            NextOrder = 0;
+        }
+        Nodes[NodeIndex].GlobalOrder = NextOrder++;
+    }
+    Stats.RankCount = MaxRank + 1;
+
+    // Summarize the coarsening for verbose diagnostics.
+    int32 LaneCount = 0;
+    for (const FLaneBlock &Block : Blocks) {
+        LaneCount += Block.bIsLane ? 1 : 0;
+    }
+    LAYOUT_LOG(Verbose,
+               TEXT("LaneLayout: nodes=%d blocks=%d lanes=%d junctions=%d ")
+                   TEXT("columns=%d ranks=%d"),
+               NodeCount, Blocks.Num(), LaneCount, Blocks.Num() - LaneCount,
+               ColumnCount, MaxRank + 1);
+    return true;
+}
+} // namespace GraphLayout
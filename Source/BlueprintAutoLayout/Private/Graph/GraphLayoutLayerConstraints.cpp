@@ -0,0 +1,184 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Layer constraint interface definitions.
+#include "Graph/GraphLayoutLayerConstraints.h"
+
+// Layer constraint solver implementation.
+namespace GraphLayout
+{
+namespace
+{
+// Fill CSR ranges that list constraint indices per node in list order.
+void BuildConstraintRanges(const TLayoutArray<FLayerConstraint> &Constraints,
+                           int32 NodeCount, bool bBySource,
+                           TLayoutArray<int32> &OutOffsets,
+                           TLayoutArray<int32> &OutIndices)
+{
+    OutOffsets.Init(0, NodeCount + 1);
+    for (const FLayerConstraint &Constraint : Constraints) {
+        ++OutOffsets[(bBySource ? Constraint.Src : Constraint.Dst) + 1];
+    }
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        OutOffsets[NodeIndex + 1] += OutOffsets[NodeIndex];
+    }
+
+    // Walking the list in order keeps each node's range in list order.
+    TLayoutArray<int32> Cursor(OutOffsets.GetData(), NodeCount);
+    OutIndices.SetNumUninitialized(Constraints.Num());
+    for (int32 Index = 0; Index < Constraints.Num(); ++Index) {
+        const FLayerConstraint &Constraint = Constraints[Index];
+        OutIndices[Cursor[bBySource ? Constraint.Src : Constraint.Dst]++] = Index;
+    }
+}
+
+// Fixed-capacity FIFO of node indices; each node is queued at most once at a time.
+struct FNodeQueue
+{
+    explicit FNodeQueue(int32 NodeCount)
+    {
+        Slots.SetNumUninitialized(FMath::Max(1, NodeCount));
+        bQueued.Init(false, NodeCount);
+    }
+
+    void Push(int32 NodeIndex)
+    {
+        if (bQueued[NodeIndex]) {
+            return;
+        }
+        bQueued[NodeIndex] = true;
+        Slots[(Head + Count) % Slots.Num()] = NodeIndex;
+        ++Count;
+    }
+
+    int32 Pop()
+    {
+        const int32 NodeIndex = Slots[Head];
+        Head = (Head + 1) % Slots.Num();
+        --Count;
+        bQueued[NodeIndex] = false;
+        return NodeIndex;
+    }
+
+    bool IsEmpty() const
+    {
+        return Count == 0;
+    }
+
+    TLayoutArray<int32> Slots;
+    TLayoutArray<bool> bQueued;
+    int32 Head = 0;
+    int32 Count = 0;
+};
+} // namespace
+
+void BuildLayerConstraintSystem(int32 NodeCount,
+                                TLayoutArray<FLayerConstraint> &&Constraints,
+                                FLayerConstraintSystem &OutSystem)
+{
+    OutSystem.NodeCount = NodeCount;
+    OutSystem.Constraints = MoveTemp(Constraints);
+    BuildConstraintRanges(OutSystem.Constraints, NodeCount, true, OutSystem.SrcOffsets,
+                          OutSystem.SrcConstraints);
+    BuildConstraintRanges(OutSystem.Constraints, NodeCount, false, OutSystem.DstOffsets,
+                          OutSystem.DstConstraints);
+}
+
+FLayerConstraintStats SolveLayerLowerBounds(const FLayerConstraintSystem &System,
+                                            TLayoutArray<int32> &InOutRanks)
+{
+    FLayerConstraintStats Stats;
+    const int32 NodeCount = System.NodeCount;
+    if (NodeCount == 0 || System.Constraints.Num() == 0) {
+        return Stats;
+    }
+
+    // Keep the starting ranks for the infeasible fallback.
+    const TLayoutArray<int32> InitialRanks = InOutRanks;
+
+    // Seed sources by first appearance so the visit order follows the list.
+    FNodeQueue Queue(NodeCount);
+    for (const FLayerConstraint &Constraint : System.Constraints) {
+        Queue.Push(Constraint.Src);
+    }
+
+    TLayoutArray<int32> VisitCounts;
+    VisitCounts.Init(0, NodeCount);
+    while (!Queue.IsEmpty()) {
+        const int32 NodeIndex = Queue.Pop();
+        ++Stats.Visits;
+        if (++VisitCounts[NodeIndex] > NodeCount) {
+            Stats.bFeasible = false;
+            break;
+        }
+
+        // Relax outgoing constraints in list order.
+        const int32 SrcRank = InOutRanks[NodeIndex];
+        for (int32 Slot = System.SrcOffsets[NodeIndex];
+             Slot < System.SrcOffsets[NodeIndex + 1]; ++Slot) {
+            const FLayerConstraint &Constraint =
+                System.Constraints[System.SrcConstraints[Slot]];
+            const int32 Candidate = SrcRank + Constraint.Weight;
+            if (Candidate > InOutRanks[Constraint.Dst]) {
+                InOutRanks[Constraint.Dst] = Candidate;
+                ++Stats.Relaxations;
+                Queue.Push(Constraint.Dst);
+            }
+        }
+    }
+
+    // Infeasible: keep a single forward pass in list order instead.
+    if (!Stats.bFeasible) {
+        InOutRanks = InitialRanks;
+        for (const FLayerConstraint &Constraint : System.Constraints) {
+            const int32 Candidate = InOutRanks[Constraint.Src] + Constraint.Weight;
+            InOutRanks[Constraint.Dst] = FMath::Max(InOutRanks[Constraint.Dst], Candidate);
+        }
+    }
+    return Stats;
+}
+
+FLayerConstraintStats PullLayerSources(const FLayerConstraintSystem &System,
+                                       const TLayoutArray<int32> &SeedOrder,
+                                       TLayoutArray<int32> &InOutRanks)
+{
+    FLayerConstraintStats Stats;
+    const int32 NodeCount = System.NodeCount;
+    if (NodeCount == 0 || System.Constraints.Num() == 0) {
+        return Stats;
+    }
+
+    // Only nodes that own constraints can move.
+    FNodeQueue Queue(NodeCount);
+    for (int32 NodeIndex : SeedOrder) {
+        if (System.SrcOffsets[NodeIndex] < System.SrcOffsets[NodeIndex + 1]) {
+            Queue.Push(NodeIndex);
+        }
+    }
+
+    // Ranks only rise and never pass the largest starting rank, so this terminates.
+    while (!Queue.IsEmpty()) {
+        const int32 NodeIndex = Queue.Pop();
+        ++Stats.Visits;
+        int32 TargetRank = MAX_int32;
+        for (int32 Slot = System.SrcOffsets[NodeIndex];
+             Slot < System.SrcOffsets[NodeIndex + 1]; ++Slot) {
+            const FLayerConstraint &Constraint =
+                System.Constraints[System.SrcConstraints[Slot]];
+            TargetRank =
+                FMath::Min(TargetRank, InOutRanks[Constraint.Dst] - Constraint.Weight);
+        }
+        if (TargetRank <= InOutRanks[NodeIndex]) {
+            continue;
+        }
+        InOutRanks[NodeIndex] = TargetRank;
+        ++Stats.Relaxations;
+
+        // Sources pulled toward this node may now move further.
+        for (int32 Slot = System.DstOffsets[NodeIndex];
+             Slot < System.DstOffsets[NodeIndex + 1]; ++Slot) {
+            Queue.Push(System.Constraints[System.DstConstraints[Slot]].Src);
+        }
+    }
+    return Stats;
+}
+} // namespace GraphLayout
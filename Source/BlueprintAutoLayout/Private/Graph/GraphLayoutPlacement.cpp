@@ -5,6 +5,7 @@
 
 // Logging and key utilities for deterministic placement.
 #include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutTrace.h"
 #include "Graph/GraphLayoutKeyUtils.h"
 
 // Graph layout placement implementation.
@@ -19,25 +20,9 @@ bool NodeKeyLess(const FNodeKey &A, const FNodeKey &B)
 }
 } // namespace
 
-// Place nodes by rank order using basic stacking and alignment.
-FGlobalPlacement PlaceGlobalRankOrder(
-    const TArray<FLayoutNode> &Nodes, float NodeSpacingXExec, float NodeSpacingXData,
-    float NodeSpacingYExec, float NodeSpacingYData,
-    EBlueprintAutoLayoutRankAlignment RankAlignment,
-    EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment)
+void BuildRankColumns(TConstArrayView<FLayoutNode> Nodes, float NodeSpacingXExec,
+                      float NodeSpacingXData, FRankColumns &OutColumns)
 {
-    // Initialize the result and early-out when there is nothing to place.
-    FGlobalPlacement Result;
-    if (Nodes.IsEmpty()) {
-        return Result;
-    }
-
-    // Clamp spacing inputs to non-negative values.
-    NodeSpacingXExec = FMath::Max(0.0f, NodeSpacingXExec);
-    NodeSpacingXData = FMath::Max(0.0f, NodeSpacingXData);
-    NodeSpacingYExec = FMath::Max(0.0f, NodeSpacingYExec);
-    NodeSpacingYData = FMath::Max(0.0f, NodeSpacingYData);
-
     // Scan nodes to find the maximum rank used for layout sizing.
     int32 MaxRank = 0;
     for (const FLayoutNode &Node : Nodes) {
@@ -46,8 +31,8 @@ FGlobalPlacement PlaceGlobalRankOrder(
     }
 
     // Compute per-rank widths and spacing based on node types.
-    TArray<float> RankWidth;
-    TArray<float> RankSpacingX;
+    TLayoutArray<float> &RankWidth = OutColumns.Width;
+    TLayoutArray<float> RankSpacingX;
     RankWidth.Init(0.0f, MaxRank + 1);
     RankSpacingX.Init(0.0f, MaxRank + 1);
     for (const FLayoutNode &Node : Nodes) {
@@ -66,26 +51,51 @@ FGlobalPlacement PlaceGlobalRankOrder(
     }
 
     // Convert per-rank widths into left-edge offsets with spacing applied.
-    TArray<float> RankXLeft;
+    TLayoutArray<float> &RankXLeft = OutColumns.XLeft;
     RankXLeft.Init(0.0f, MaxRank + 1);
     float XOffset = 0.0f;
     for (int32 Rank = 0; Rank < RankXLeft.Num(); ++Rank) {
         RankXLeft[Rank] = XOffset;
         XOffset += RankWidth[Rank] + RankSpacingX[Rank];
     }
+}
+
+float GetColumnAlignedX(const FRankColumns &Columns, const FLayoutNode &Node,
+                        EBlueprintAutoLayoutRankAlignment RankAlignment,
+                        EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment)
+{
+    const int32 Rank = FMath::Max(0, Node.GlobalRank);
+    const EBlueprintAutoLayoutRankAlignment Alignment =
+        Node.bIsVariableGet ? VariableGetRankAlignment : RankAlignment;
+    const float Extra = FMath::Max(0.0f, Columns.Width[Rank] - Node.Size.X);
+    switch (Alignment) {
+    case EBlueprintAutoLayoutRankAlignment::Left:
+        return Columns.XLeft[Rank];
+    case EBlueprintAutoLayoutRankAlignment::Right:
+        return Columns.XLeft[Rank] + Extra;
+    case EBlueprintAutoLayoutRankAlignment::Center:
+    default:
+        return Columns.XLeft[Rank] + Extra * 0.5f;
+    }
+}
 
+void BuildSortedRankNodes(TConstArrayView<FLayoutNode> Nodes,
+                          FLayoutIndexLists &OutRankNodes)
+{
     // Group node indices by their rank for per-layer ordering.
-    TArray<TArray<int32>> RankNodes;
-    RankNodes.SetNum(MaxRank + 1);
+    int32 MaxRank = 0;
+    for (const FLayoutNode &Node : Nodes) {
+        MaxRank = FMath::Max(MaxRank, Node.GlobalRank);
+    }
+    OutRankNodes.Reset();
+    OutRankNodes.SetNum(MaxRank + 1);
     for (int32 Index = 0; Index < Nodes.Num(); ++Index) {
         const int32 Rank = FMath::Max(0, Nodes[Index].GlobalRank);
-        RankNodes[Rank].Add(Index);
+        OutRankNodes[Rank].Add(Index);
     }
 
-    // Lay out each rank using per-node vertical spacing.
-    for (int32 Rank = 0; Rank < RankNodes.Num(); ++Rank) {
-        // Sort within a rank by explicit order, then by stable key.
-        TArray<int32> &Layer = RankNodes[Rank];
+    // Sort within each rank by explicit order, then by stable key.
+    for (TLayoutArray<int32> &Layer : OutRankNodes) {
         Layer.Sort([&](int32 A, int32 B) {
             const FLayoutNode &NodeA = Nodes[A];
             const FLayoutNode &NodeB = Nodes[B];
@@ -94,50 +104,81 @@ FGlobalPlacement PlaceGlobalRankOrder(
             }
             return NodeKeyLess(NodeA.Key, NodeB.Key);
         });
+    }
+}
+
+void SelectExecAlignmentEdges(TConstArrayView<FLayoutNode> Nodes,
+                              TConstArrayView<FLayoutEdge> Edges,
+                              TLayoutArray<int32> &OutEdgeIndex)
+{
+    OutEdgeIndex.Init(INDEX_NONE, Nodes.Num());
 
-        // Position nodes within their rank column and stacked by order.
-        auto GetSpacingY = [&](const FLayoutNode &Node) {
-            return Node.bHasExecPins ? NodeSpacingYExec : NodeSpacingYData;
-        };
-        auto GetAlignedOffset = [&](float ColumnWidth, float NodeWidth,
-                                    EBlueprintAutoLayoutRankAlignment Alignment) {
-            const float Extra = FMath::Max(0.0f, ColumnWidth - NodeWidth);
-            switch (Alignment) {
-            case EBlueprintAutoLayoutRankAlignment::Left:
-                return 0.0f;
-            case EBlueprintAutoLayoutRankAlignment::Right:
-                return Extra;
-            case EBlueprintAutoLayoutRankAlignment::Center:
-            default:
-                return Extra * 0.5f;
+    // Prefer adjacent-rank sources with the smallest order before stable tie-breaks.
+    auto IsPreferredExecEdge = [&](const FLayoutEdge &Candidate, int32 CandidateIndex,
+                                   int32 CurrentIndex) {
+        const bool bIsRerouteSrc = Nodes[Candidate.Src].bIsReroute;
+        if (bIsRerouteSrc) {
+            return false;
+        }
+        if (CurrentIndex == INDEX_NONE) {
+            return true;
+        }
+        const FLayoutEdge &Current = Edges[CurrentIndex];
+        const int32 DstRank = Nodes[Candidate.Dst].GlobalRank;
+        const bool bCandidateAdjacent = Nodes[Candidate.Src].GlobalRank == DstRank - 1;
+        const bool bCurrentAdjacent = Nodes[Current.Src].GlobalRank == DstRank - 1;
+        if (bCandidateAdjacent != bCurrentAdjacent) {
+            return bCandidateAdjacent;
+        }
+        if (bCandidateAdjacent) {
+            const int32 CandidateOrder = Nodes[Candidate.Src].GlobalOrder;
+            const int32 CurrentOrder = Nodes[Current.Src].GlobalOrder;
+            if (CandidateOrder != CurrentOrder) {
+                return CandidateOrder < CurrentOrder;
             }
-        };
+        }
+        if (Candidate.Src != Current.Src) {
+            return NodeKeyLess(Nodes[Candidate.Src].Key, Nodes[Current.Src].Key);
+        }
+        if (Candidate.SrcPinName != Current.SrcPinName) {
+            return Candidate.SrcPinName.LexicalLess(Current.SrcPinName);
+        }
+        if (Candidate.SrcPinIndex != Current.SrcPinIndex) {
+            return Candidate.SrcPinIndex < Current.SrcPinIndex;
+        }
+        if (Candidate.DstPinName != Current.DstPinName) {
+            return Candidate.DstPinName.LexicalLess(Current.DstPinName);
+        }
+        if (Candidate.DstPinIndex != Current.DstPinIndex) {
+            return Candidate.DstPinIndex < Current.DstPinIndex;
+        }
+        if (Candidate.StableKey != Current.StableKey) {
+            return Candidate.StableKey < Current.StableKey;
+        }
+        return CandidateIndex < CurrentIndex;
+    };
 
-        // Stack nodes vertically within the rank using spacing rules.
-        float YOffset = 0.0f;
-        for (int32 LayerOrder = 0; LayerOrder < Layer.Num(); ++LayerOrder) {
-            const int32 Index = Layer[LayerOrder];
-            const FLayoutNode &Node = Nodes[Index];
-            const int32 Order = LayerOrder;
-            const EBlueprintAutoLayoutRankAlignment Alignment =
-                Node.bIsVariableGet ? VariableGetRankAlignment : RankAlignment;
-            const float X = RankXLeft[Rank] +
-                            GetAlignedOffset(RankWidth[Rank], Node.Size.X, Alignment);
-            const float Y = YOffset;
-            const TCHAR *NodeName =
-                Node.Name.IsEmpty() ? TEXT("<unnamed>") : *Node.Name;
-            const FString GuidString =
-                Node.Key.Guid.ToString(EGuidFormats::DigitsWithHyphens);
-            UE_LOG(LogBlueprintAutoLayout, Verbose,
-                   TEXT("  Placing node guid=%s name=%s rank=%d order=%d "
-                        "original_order=%d at (%.1f, %.1f)"),
-                   *GuidString, NodeName, Node.GlobalRank, Order, Node.GlobalOrder, X,
-                   Y);
-            Result.Positions.Add(Index, FVector2f(X, Y));
-            YOffset += Node.Size.Y + GetSpacingY(Node);
+    // Scan exec edges to select the alignment edge for each destination.
+    for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex) {
+        const FLayoutEdge &Edge = Edges[EdgeIndex];
+        if (Edge.Kind != EEdgeKind::Exec) {
+            continue;
+        }
+        if (!Nodes.IsValidIndex(Edge.Src) || !Nodes.IsValidIndex(Edge.Dst)) {
+            continue;
+        }
+        if (Edge.Src == Edge.Dst) {
+            continue;
+        }
+        const int32 CurrentIndex = OutEdgeIndex[Edge.Dst];
+        if (IsPreferredExecEdge(Edge, EdgeIndex, CurrentIndex)) {
+            OutEdgeIndex[Edge.Dst] = EdgeIndex;
         }
     }
+}
 
+int32 SelectPlacementAnchor(TConstArrayView<FLayoutNode> Nodes)
+{
     // Prefer an anchor with exec pins, then stable key, then index order.
     auto IsBetterAnchor = [&](int32 Candidate, int32 Current) {
         if (Candidate == INDEX_NONE) {
@@ -179,30 +220,76 @@ FGlobalPlacement PlaceGlobalRankOrder(
             }
         }
     }
+    return AnchorIndex;
+}
+
+// Place nodes by rank order using basic stacking and alignment.
+FGlobalPlacement PlaceGlobalRankOrder(
+    TConstArrayView<FLayoutNode> Nodes, float NodeSpacingXExec,
+    float NodeSpacingXData, float NodeSpacingYExec, float NodeSpacingYData,
+    EBlueprintAutoLayoutRankAlignment RankAlignment,
+    EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment)
+{
+    // Initialize the result and early-out when there is nothing to place.
+    FGlobalPlacement Result;
+    if (Nodes.IsEmpty()) {
+        return Result;
+    }
+    Result.Positions.SetNumZeroed(Nodes.Num());
+
+    // Clamp spacing inputs to non-negative values.
+    NodeSpacingXExec = FMath::Max(0.0f, NodeSpacingXExec);
+    NodeSpacingXData = FMath::Max(0.0f, NodeSpacingXData);
+    NodeSpacingYExec = FMath::Max(0.0f, NodeSpacingYExec);
+    NodeSpacingYData = FMath::Max(0.0f, NodeSpacingYData);
+
+    // Size rank columns and order each rank's nodes.
+    FRankColumns Columns;
+    BuildRankColumns(Nodes, NodeSpacingXExec, NodeSpacingXData, Columns);
+    FLayoutIndexLists RankNodes;
+    BuildSortedRankNodes(Nodes, RankNodes);
+
+    // Stack nodes vertically within each rank using per-node spacing.
+    for (const TLayoutArray<int32> &Layer : RankNodes) {
+        float YOffset = 0.0f;
+        for (int32 LayerOrder = 0; LayerOrder < Layer.Num(); ++LayerOrder) {
+            const int32 Index = Layer[LayerOrder];
+            const FLayoutNode &Node = Nodes[Index];
+            const float X = GetColumnAlignedX(Columns, Node, RankAlignment,
+                                              VariableGetRankAlignment);
+            const float Y = YOffset;
+            LAYOUT_LOG(Verbose,
+                       TEXT("  Placing node guid=%s name=%s rank=%d order=%d "
+                            "original_order=%d at (%.1f, %.1f)"),
+                       *Node.Key.Guid.ToString(EGuidFormats::DigitsWithHyphens),
+                       Node.Name.IsEmpty() ? TEXT("<unnamed>") : *Node.Name,
+                       Node.GlobalRank, LayerOrder, Node.GlobalOrder, X, Y);
+            Result.Positions[Index] = FVector2f(X, Y);
+            YOffset += Node.Size.Y +
+                       (Node.bHasExecPins ? NodeSpacingYExec : NodeSpacingYData);
+        }
+    }
 
     // Record the anchor selection for consumers that need a reference origin.
-    Result.AnchorNodeIndex = AnchorIndex;
+    Result.AnchorNodeIndex = SelectPlacementAnchor(Nodes);
     return Result;
 }
 
 // Compute the offset that keeps the selected anchor aligned to its original position.
-FVector2f ComputeGlobalAnchorOffset(const TArray<FLayoutNode> &Nodes,
+FVector2f ComputeGlobalAnchorOffset(TConstArrayView<FLayoutNode> Nodes,
                                     const FGlobalPlacement &Placement)
 {
     // When no anchor was chosen, keep the layout origin unchanged.
     if (Placement.AnchorNodeIndex == INDEX_NONE) {
         return FVector2f::ZeroVector;
     }
-    // Require a stored position for the anchor in the placement map.
-    const FVector2f *AnchorPos = Placement.Positions.Find(Placement.AnchorNodeIndex);
-    if (!AnchorPos) {
-        return FVector2f::ZeroVector;
-    }
-    // Ensure the anchor index is valid for the provided node array.
-    if (!Nodes.IsValidIndex(Placement.AnchorNodeIndex)) {
+    // Ensure the anchor index is valid for the placement and the node array.
+    if (!Placement.Positions.IsValidIndex(Placement.AnchorNodeIndex) ||
+        !Nodes.IsValidIndex(Placement.AnchorNodeIndex)) {
         return FVector2f::ZeroVector;
     }
     // Offset so the anchor aligns with its original position.
-    return Nodes[Placement.AnchorNodeIndex].Position - *AnchorPos;
+    return Nodes[Placement.AnchorNodeIndex].Position -
+           Placement.Positions[Placement.AnchorNodeIndex];
 }
 } // namespace GraphLayout
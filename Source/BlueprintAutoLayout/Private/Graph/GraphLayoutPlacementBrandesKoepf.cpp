@@ -0,0 +1,443 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Placement interface definitions.
+#include "Graph/GraphLayoutPlacement.h"
+
+// Logging and sorting for deterministic placement.
+#include "Algo/Sort.h"
+#include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutTrace.h"
+
+// Brandes-Koepf placement implementation.
+namespace GraphLayout
+{
+namespace
+{
+// Number of alignment directions combined by the balancing step.
+constexpr int32 kAlignmentCount = 4;
+
+// Edge between adjacent ranks; Upper is the endpoint on the lower rank number.
+struct FAlignSegment
+{
+    int32 Upper = INDEX_NONE;
+    int32 Lower = INDEX_NONE;
+
+    // Chosen exec alignment edges are aligned first; data segments crossing one are
+    // marked as conflicts and never aligned.
+    bool bPriority = false;
+    bool bConflict = false;
+};
+
+// Adjacent-rank segments with per-node lists sorted by the other endpoint's order.
+// Segments ending at node I from the previous rank are
+// UpperSlots[UpperOffsets[I], UpperOffsets[I + 1]); LowerSlots mirrors that for
+// segments toward the next rank.
+struct FAlignGraph
+{
+    TLayoutArray<int32> Pos;
+    TLayoutArray<FAlignSegment> Segments;
+    TLayoutArray<int32> UpperOffsets;
+    TLayoutArray<int32> UpperSlots;
+    TLayoutArray<int32> LowerOffsets;
+    TLayoutArray<int32> LowerSlots;
+};
+
+// One of the four alignments: which neighbor rank blocks follow, and whether
+// ranks are scanned from their last order upward.
+struct FAlignDirection
+{
+    bool bUseUpper = true;
+    bool bReverse = false;
+};
+
+// Group segment indices by one endpoint in CSR form, each list ordered by the
+// position of the opposite endpoint and then by segment index.
+void BuildSegmentLists(TConstArrayView<FAlignSegment> Segments,
+                       const TLayoutArray<int32> &Pos, int32 NodeCount, bool bByLower,
+                       TLayoutArray<int32> &OutOffsets, TLayoutArray<int32> &OutSlots)
+{
+    OutOffsets.Init(0, NodeCount + 1);
+    for (const FAlignSegment &Segment : Segments) {
+        ++OutOffsets[(bByLower ? Segment.Lower : Segment.Upper) + 1];
+    }
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        OutOffsets[NodeIndex + 1] += OutOffsets[NodeIndex];
+    }
+    OutSlots.SetNumUninitialized(Segments.Num());
+    TLayoutArray<int32> Cursor = OutOffsets;
+    for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num(); ++SegmentIndex) {
+        const FAlignSegment &Segment = Segments[SegmentIndex];
+        OutSlots[Cursor[bByLower ? Segment.Lower : Segment.Upper]++] = SegmentIndex;
+    }
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        const int32 Begin = OutOffsets[NodeIndex];
+        const int32 Count = OutOffsets[NodeIndex + 1] - Begin;
+        Algo::Sort(TArrayView<int32>(OutSlots.GetData() + Begin, Count),
+                   [&](int32 A, int32 B) {
+                       const int32 PosA =
+                           Pos[bByLower ? Segments[A].Upper : Segments[A].Lower];
+                       const int32 PosB =
+                           Pos[bByLower ? Segments[B].Upper : Segments[B].Lower];
+                       return PosA != PosB ? PosA < PosB : A < B;
+                   });
+    }
+}
+
+// Collect segments between adjacent ranks. Longer edges have no dummy nodes at
+// this stage, so they do not take part in alignment.
+void BuildAlignGraph(TConstArrayView<FLayoutNode> Nodes,
+                     TConstArrayView<FLayoutEdge> Edges,
+                     const FLayoutIndexLists &RankNodes,
+                     const TLayoutArray<int32> &ExecAlignEdgeIndex,
+                     FAlignGraph &OutGraph)
+{
+    const int32 NodeCount = Nodes.Num();
+    OutGraph.Pos.SetNumUninitialized(NodeCount);
+    for (const TLayoutArray<int32> &Layer : RankNodes) {
+        for (int32 Order = 0; Order < Layer.Num(); ++Order) {
+            OutGraph.Pos[Layer[Order]] = Order;
+        }
+    }
+
+    OutGraph.Segments.Reset(Edges.Num());
+    for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex) {
+        const FLayoutEdge &Edge = Edges[EdgeIndex];
+        if (!Nodes.IsValidIndex(Edge.Src) || !Nodes.IsValidIndex(Edge.Dst)) {
+            continue;
+        }
+        const int32 SrcRank = FMath::Max(0, Nodes[Edge.Src].GlobalRank);
+        const int32 DstRank = FMath::Max(0, Nodes[Edge.Dst].GlobalRank);
+        if (FMath::Abs(SrcRank - DstRank) != 1) {
+            continue;
+        }
+        FAlignSegment Segment;
+        Segment.Upper = SrcRank < DstRank ? Edge.Src : Edge.Dst;
+        Segment.Lower = SrcRank < DstRank ? Edge.Dst : Edge.Src;
+        Segment.bPriority = Edge.Kind == EEdgeKind::Exec && SrcRank < DstRank &&
+                            ExecAlignEdgeIndex[Edge.Dst] == EdgeIndex;
+        OutGraph.Segments.Add(Segment);
+    }
+    BuildSegmentLists(OutGraph.Segments, OutGraph.Pos, NodeCount, true,
+                      OutGraph.UpperOffsets, OutGraph.UpperSlots);
+    BuildSegmentLists(OutGraph.Segments, OutGraph.Pos, NodeCount, false,
+                      OutGraph.LowerOffsets, OutGraph.LowerSlots);
+}
+
+// Mark data segments that cross a priority segment (Brandes-Koepf type 1
+// conflicts, with exec alignment edges in the role of inner segments). Each node
+// of the lower rank is scanned once, so the pass is linear in the segment count.
+void MarkAlignmentConflicts(const FLayoutIndexLists &RankNodes, FAlignGraph &Graph)
+{
+    for (int32 Rank = 0; Rank + 1 < RankNodes.Num(); ++Rank) {
+        const TLayoutArray<int32> &Upper = RankNodes[Rank];
+        const TLayoutArray<int32> &Lower = RankNodes[Rank + 1];
+        int32 K0 = 0;
+        int32 Scan = 0;
+        for (int32 L1 = 0; L1 < Lower.Num(); ++L1) {
+            const int32 Node = Lower[L1];
+            int32 PriorityUpper = INDEX_NONE;
+            for (int32 Slot = Graph.UpperOffsets[Node];
+                 Slot < Graph.UpperOffsets[Node + 1]; ++Slot) {
+                const FAlignSegment &Segment = Graph.Segments[Graph.UpperSlots[Slot]];
+                if (Segment.bPriority) {
+                    PriorityUpper = Segment.Upper;
+                    break;
+                }
+            }
+            if (L1 + 1 < Lower.Num() && PriorityUpper == INDEX_NONE) {
+                continue;
+            }
+
+            // Segments into Lower[Scan..L1] must stay within [K0, K1] upstairs.
+            const int32 K1 = PriorityUpper != INDEX_NONE ? Graph.Pos[PriorityUpper]
+                                                         : Upper.Num() - 1;
+            for (; Scan <= L1; ++Scan) {
+                const int32 Member = Lower[Scan];
+                for (int32 Slot = Graph.UpperOffsets[Member];
+                     Slot < Graph.UpperOffsets[Member + 1]; ++Slot) {
+                    FAlignSegment &Segment = Graph.Segments[Graph.UpperSlots[Slot]];
+                    const int32 K = Graph.Pos[Segment.Upper];
+                    if (!Segment.bPriority && (K < K0 || K > K1)) {
+                        Segment.bConflict = true;
+                    }
+                }
+            }
+            K0 = K1;
+        }
+    }
+}
+
+// Vertical alignment: chain each node to a median neighbor in the adjacent rank,
+// trying its priority segment first. Positions of aligned neighbors must increase
+// along the scan so blocks never cross. Block roots end up in OutRoot.
+void AlignBlocks(const FAlignGraph &Graph, const FLayoutIndexLists &RankNodes,
+                 const FAlignDirection &Direction, TLayoutArray<int32> &OutRoot)
+{
+    const int32 NodeCount = Graph.Pos.Num();
+    TLayoutArray<int32> Align;
+    Align.SetNumUninitialized(NodeCount);
+    OutRoot.SetNumUninitialized(NodeCount);
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        Align[NodeIndex] = NodeIndex;
+        OutRoot[NodeIndex] = NodeIndex;
+    }
+    const TLayoutArray<int32> &Offsets =
+        Direction.bUseUpper ? Graph.UpperOffsets : Graph.LowerOffsets;
+    const TLayoutArray<int32> &Slots =
+        Direction.bUseUpper ? Graph.UpperSlots : Graph.LowerSlots;
+
+    const int32 RankCount = RankNodes.Num();
+    for (int32 RankStep = 1; RankStep < RankCount; ++RankStep) {
+        const int32 Rank = Direction.bUseUpper ? RankStep : RankCount - 1 - RankStep;
+        const TLayoutArray<int32> &Layer = RankNodes[Rank];
+        int32 LastPos = Direction.bReverse ? MAX_int32 : INDEX_NONE;
+        for (int32 Step = 0; Step < Layer.Num(); ++Step) {
+            const int32 Order = Direction.bReverse ? Layer.Num() - 1 - Step : Step;
+            const int32 Node = Layer[Order];
+            const int32 Begin = Offsets[Node];
+            const int32 Count = Offsets[Node + 1] - Begin;
+            if (Count == 0) {
+                continue;
+            }
+
+            // Priority segment in scan order, then the one or two medians.
+            int32 Candidates[3];
+            int32 CandidateCount = 0;
+            for (int32 Index = 0; Index < Count; ++Index) {
+                const int32 Slot =
+                    Begin + (Direction.bReverse ? Count - 1 - Index : Index);
+                if (Graph.Segments[Slots[Slot]].bPriority) {
+                    Candidates[CandidateCount++] = Slot;
+                    break;
+                }
+            }
+            const int32 LowMedian = Begin + (Count - 1) / 2;
+            const int32 HighMedian = Begin + Count / 2;
+            Candidates[CandidateCount++] = Direction.bReverse ? HighMedian : LowMedian;
+            if (LowMedian != HighMedian) {
+                Candidates[CandidateCount++] =
+                    Direction.bReverse ? LowMedian : HighMedian;
+            }
+
+            for (int32 Index = 0; Index < CandidateCount && Align[Node] == Node;
+                 ++Index) {
+                const FAlignSegment &Segment = Graph.Segments[Slots[Candidates[Index]]];
+                if (Segment.bConflict) {
+                    continue;
+                }
+                const int32 Neighbor =
+                    Direction.bUseUpper ? Segment.Upper : Segment.Lower;
+                const int32 NeighborPos = Graph.Pos[Neighbor];
+                if (Direction.bReverse ? NeighborPos >= LastPos
+                                       : NeighborPos <= LastPos) {
+                    continue;
+                }
+                Align[Neighbor] = Node;
+                OutRoot[Node] = OutRoot[Neighbor];
+                Align[Node] = OutRoot[Node];
+                LastPos = NeighborPos;
+            }
+        }
+    }
+}
+
+// Horizontal compaction as a longest path over the block graph: each node's scan
+// predecessor in its rank pushes the node's block by the pair's separation. Block
+// order follows rank order, so the graph is acyclic; returns false otherwise.
+bool CompactBlocks(TConstArrayView<FLayoutNode> Nodes,
+                   const FLayoutIndexLists &RankNodes, const TLayoutArray<int32> &Root,
+                   bool bReverse, float NodeSpacingYExec, float NodeSpacingYData,
+                   TLayoutArray<float> &OutY)
+{
+    // Gap between a node and the node directly below it in a rank.
+    auto Separation = [&](int32 Above, int32 Below) {
+        return Nodes[Above].Size.Y +
+               (Nodes[Below].bHasExecPins ? NodeSpacingYExec : NodeSpacingYData);
+    };
+
+    // Build block graph edges in CSR form keyed by the predecessor's root.
+    const int32 NodeCount = Nodes.Num();
+    TLayoutArray<int32> Offsets;
+    Offsets.Init(0, NodeCount + 1);
+    TLayoutArray<int32> InDegree;
+    InDegree.Init(0, NodeCount);
+    for (const TLayoutArray<int32> &Layer : RankNodes) {
+        for (int32 Order = 1; Order < Layer.Num(); ++Order) {
+            const int32 Pred = bReverse ? Layer[Order] : Layer[Order - 1];
+            const int32 Node = bReverse ? Layer[Order - 1] : Layer[Order];
+            ++Offsets[Root[Pred] + 1];
+            ++InDegree[Root[Node]];
+        }
+    }
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        Offsets[NodeIndex + 1] += Offsets[NodeIndex];
+    }
+    TLayoutArray<int32> Targets;
+    TLayoutArray<float> Weights;
+    Targets.SetNumUninitialized(Offsets[NodeCount]);
+    Weights.SetNumUninitialized(Offsets[NodeCount]);
+    TLayoutArray<int32> Cursor = Offsets;
+    for (const TLayoutArray<int32> &Layer : RankNodes) {
+        for (int32 Order = 1; Order < Layer.Num(); ++Order) {
+            const int32 Above = Layer[Order - 1];
+            const int32 Below = Layer[Order];
+            const int32 Pred = bReverse ? Below : Above;
+            const int32 Node = bReverse ? Above : Below;
+            const int32 Slot = Cursor[Root[Pred]]++;
+            Targets[Slot] = Root[Node];
+            Weights[Slot] = Separation(Above, Below);
+        }
+    }
+
+    // Kahn order seeded by node index keeps the traversal deterministic.
+    TLayoutArray<float> Coord;
+    Coord.Init(0.0f, NodeCount);
+    TLayoutArray<int32> Queue;
+    Queue.Reserve(NodeCount);
+    int32 RootCount = 0;
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        if (Root[NodeIndex] != NodeIndex) {
+            continue;
+        }
+        ++RootCount;
+        if (InDegree[NodeIndex] == 0) {
+            Queue.Add(NodeIndex);
+        }
+    }
+    for (int32 Head = 0; Head < Queue.Num(); ++Head) {
+        const int32 Block = Queue[Head];
+        for (int32 Slot = Offsets[Block]; Slot < Offsets[Block + 1]; ++Slot) {
+            const int32 Target = Targets[Slot];
+            Coord[Target] = FMath::Max(Coord[Target], Coord[Block] + Weights[Slot]);
+            if (--InDegree[Target] == 0) {
+                Queue.Add(Target);
+            }
+        }
+    }
+    if (Queue.Num() != RootCount) {
+        return false;
+    }
+
+    // Reverse scans compact upward, so their coordinates grow toward the top.
+    OutY.SetNumUninitialized(NodeCount);
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex) {
+        const float Value = Coord[Root[NodeIndex]];
+        OutY[NodeIndex] = bReverse ? -Value : Value;
+    }
+    return true;
+}
+} // namespace
+
+// Place nodes by Brandes-Koepf vertical alignment and horizontal compaction.
+FGlobalPlacement PlaceGlobalRankOrderBrandesKoepf(
+    TConstArrayView<FLayoutNode> Nodes, TConstArrayView<FLayoutEdge> Edges,
+    float NodeSpacingXExec, float NodeSpacingXData, float NodeSpacingYExec,
+    float NodeSpacingYData, EBlueprintAutoLayoutRankAlignment RankAlignment,
+    EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment)
+{
+    // Initialize the result and early-out when there is nothing to place.
+    FGlobalPlacement Result;
+    if (Nodes.IsEmpty()) {
+        return Result;
+    }
+    Result.Positions.SetNumZeroed(Nodes.Num());
+
+    // Clamp spacing inputs to non-negative values.
+    NodeSpacingXExec = FMath::Max(0.0f, NodeSpacingXExec);
+    NodeSpacingXData = FMath::Max(0.0f, NodeSpacingXData);
+    NodeSpacingYExec = FMath::Max(0.0f, NodeSpacingYExec);
+    NodeSpacingYData = FMath::Max(0.0f, NodeSpacingYData);
+
+    // Size rank columns and order each rank's nodes.
+    FRankColumns Columns;
+    BuildRankColumns(Nodes, NodeSpacingXExec, NodeSpacingXData, Columns);
+    FLayoutIndexLists RankNodes;
+    BuildSortedRankNodes(Nodes, RankNodes);
+
+    // The compact engine's exec alignment choices become alignment priorities.
+    TLayoutArray<int32> ExecAlignEdgeIndex;
+    SelectExecAlignmentEdges(Nodes, Edges, ExecAlignEdgeIndex);
+    FAlignGraph Graph;
+    BuildAlignGraph(Nodes, Edges, RankNodes, ExecAlignEdgeIndex, Graph);
+    MarkAlignmentConflicts(RankNodes, Graph);
+
+    // Run the four alignments and record each layout's vertical extent.
+    constexpr FAlignDirection Directions[kAlignmentCount] = {
+        {true, false}, {true, true}, {false, false}, {false, true}};
+    TLayoutArray<float> Ys[kAlignmentCount];
+    float MinY[kAlignmentCount];
+    float MaxY[kAlignmentCount];
+    TLayoutArray<int32> Root;
+    int32 BestAlignment = 0;
+    for (int32 Alignment = 0; Alignment < kAlignmentCount; ++Alignment) {
+        const FAlignDirection &Direction = Directions[Alignment];
+        AlignBlocks(Graph, RankNodes, Direction, Root);
+        if (!CompactBlocks(Nodes, RankNodes, Root, Direction.bReverse, NodeSpacingYExec,
+                           NodeSpacingYData, Ys[Alignment])) {
+            // Unaligned blocks always compact; keep the layout valid if one fails.
+            LAYOUT_LOG(Verbose,
+                       TEXT("BrandesKoepfPlacement: alignment %d formed a cyclic "
+                            "block graph; placing it unaligned"),
+                       Alignment);
+            for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex) {
+                Root[NodeIndex] = NodeIndex;
+            }
+            CompactBlocks(Nodes, RankNodes, Root, Direction.bReverse, NodeSpacingYExec,
+                          NodeSpacingYData, Ys[Alignment]);
+        }
+        MinY[Alignment] = TNumericLimits<float>::Max();
+        MaxY[Alignment] = TNumericLimits<float>::Lowest();
+        for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex) {
+            const float Y = Ys[Alignment][NodeIndex];
+            MinY[Alignment] = FMath::Min(MinY[Alignment], Y);
+            MaxY[Alignment] = FMath::Max(MaxY[Alignment], Y + Nodes[NodeIndex].Size.Y);
+        }
+        if (MaxY[Alignment] - MinY[Alignment] <
+            MaxY[BestAlignment] - MinY[BestAlignment]) {
+            BestAlignment = Alignment;
+        }
+    }
+
+    // Balance: align top-down layouts to the smallest one's top and bottom-up layouts
+    // to its bottom, then average the two median candidates per node. Each
+    // candidate respects rank separation, so their order statistics do too.
+    float Shift[kAlignmentCount];
+    for (int32 Alignment = 0; Alignment < kAlignmentCount; ++Alignment) {
+        Shift[Alignment] = Directions[Alignment].bReverse
+                               ? MaxY[BestAlignment] - MaxY[Alignment]
+                               : MinY[BestAlignment] - MinY[Alignment];
+    }
+    TLayoutArray<float> YPositions;
+    YPositions.SetNumUninitialized(Nodes.Num());
+    float TopY = TNumericLimits<float>::Max();
+    for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex) {
+        float Candidates[kAlignmentCount];
+        for (int32 Alignment = 0; Alignment < kAlignmentCount; ++Alignment) {
+            Candidates[Alignment] = Ys[Alignment][NodeIndex] + Shift[Alignment];
+        }
+        Algo::Sort(Candidates);
+        YPositions[NodeIndex] = 0.5f * (Candidates[1] + Candidates[2]);
+        TopY = FMath::Min(TopY, YPositions[NodeIndex]);
+    }
+
+    // Emit final node positions with the topmost node at zero.
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index) {
+        const FLayoutNode &Node = Nodes[Index];
+        const float X =
+            GetColumnAlignedX(Columns, Node, RankAlignment, VariableGetRankAlignment);
+        const float Y = YPositions[Index] - TopY;
+        LAYOUT_LOG(
+            Verbose,
+            TEXT("  BrandesKoepf place node guid=%s name=%s rank=%d order=%d at "
+                 "(%.1f, %.1f)"),
+            *Node.Key.Guid.ToString(EGuidFormats::DigitsWithHyphens),
+            Node.Name.IsEmpty() ? TEXT("<unnamed>") : *Node.Name, Node.GlobalRank,
+            Node.GlobalOrder, X, Y);
+        Result.Positions[Index] = FVector2f(X, Y);
+    }
+
+    // Record the anchor selection for consumers that need a reference origin.
+    Result.AnchorNodeIndex = SelectPlacementAnchor(Nodes);
+    return Result;
+}
+} // namespace GraphLayout
@@ -0,0 +1,255 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Component layout cache interface.
+#include "Graph/GraphLayoutResultCache.h"
+
+// Engine dependencies for hashing, eviction, and locking.
+#include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutTrace.h"
+#include "Containers/LruCache.h"
+#include "Graph/GraphLayoutKeyUtils.h"
+#include "Hash/xxhash.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+
+// Component layout cache implementation.
+namespace GraphLayout
+{
+namespace
+{
+// Bound for the in-memory cache; least recently used entries are evicted first.
+constexpr int32 kComponentLayoutCacheCapacity = 256;
+constexpr int32 kPriorNodeOrderCapacity = 65536;
+
+// Bump when the hashed fields or the pipeline output change meaning.
+constexpr uint32 kComponentLayoutHashVersion = 5;
+
+// Placement stored by node key slot instead of node index. Entries outlive the
+// layout arena, so they keep their own heap copy.
+struct FCachedComponentLayout
+{
+    int32 NodeCount = 0;
+    TArray<FVector2f> SlotPositions;
+    int32 AnchorSlot = INDEX_NONE;
+};
+
+// Cached placements shared by every layout thread.
+TLruCache<uint64, FCachedComponentLayout> GComponentLayoutCache(
+    kComponentLayoutCacheCapacity);
+FCriticalSection GComponentLayoutCacheLock;
+
+// Prior orders per stable node identity, used by incremental layout.
+TLruCache<uint64, FPriorNodeOrder> GPriorNodeOrders(kPriorNodeOrderCapacity);
+FCriticalSection GPriorNodeOrderLock;
+
+// Edge fields that feed the pipeline, in key slot space.
+struct FHashedEdge
+{
+    FEdgeKey StableKey;
+    int32 SrcSlot = 0;
+    int32 DstSlot = 0;
+    EEdgeKind Kind = EEdgeKind::Data;
+    const FLayoutEdge *Edge = nullptr;
+};
+
+// Append a plain value to the hash.
+template <typename T> void HashValue(FXxHash64Builder &Builder, const T &Value)
+{
+    Builder.Update(&Value, sizeof(T));
+}
+
+// Append a name by its text so the hash does not depend on name table indices.
+void HashName(FXxHash64Builder &Builder, const FName &Name)
+{
+    const FString Text = Name.ToString();
+    HashValue(Builder, Text.Len());
+    Builder.Update(*Text, Text.Len() * sizeof(TCHAR));
+}
+
+// Append every setting that changes ranks, orders, or positions.
+void HashSettings(FXxHash64Builder &Builder, const FLayoutSettings &Settings)
+{
+    HashValue(Builder, Settings.NodeSpacingX);
+    HashValue(Builder, Settings.NodeSpacingXExec);
+    HashValue(Builder, Settings.NodeSpacingXData);
+    HashValue(Builder, Settings.NodeSpacingYExec);
+    HashValue(Builder, Settings.NodeSpacingYData);
+    HashValue(Builder, Settings.VariableGetMinLength);
+    HashValue(Builder, Settings.RankAlignment);
+    HashValue(Builder, Settings.VariableGetRankAlignment);
+    HashValue(Builder, Settings.bAlignExecChainsHorizontally);
+    HashValue(Builder, Settings.Placement);
+    HashValue(Builder, Settings.bAdaptiveCrossingReduction);
+    HashValue(Builder, Settings.MaxAdaptiveCrossingSweeps);
+    HashValue(Builder, Settings.bVirtualLongEdgeChains);
+    HashValue(Builder, Settings.CrossingReduction);
+    HashValue(Builder, Settings.CrossingReductionMaxIterations);
+    HashValue(Builder, Settings.CrossingReductionTimeBudgetMs);
+    HashValue(Builder, Settings.bCoarsenExecLanes);
+    HashValue(Builder, Settings.CoarsenExecLanesMinNodes);
+    HashValue(Builder, Settings.bIncrementalLayout);
+}
+} // namespace
+
+bool BuildComponentLayoutSignature(TConstArrayView<FLayoutNode> Nodes,
+                                   TConstArrayView<FLayoutEdge> Edges,
+                                   const FLayoutSettings &Settings,
+                                   FComponentLayoutSignature &OutSignature)
+{
+    // Order node indices by key; equal keys make the order ambiguous.
+    TLayoutArray<int32> &KeyOrder = OutSignature.KeyOrder;
+    KeyOrder.Reset(Nodes.Num());
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index) {
+        KeyOrder.Add(Index);
+    }
+    KeyOrder.Sort([&Nodes](int32 A, int32 B) {
+        const int32 Compare = KeyUtils::CompareNodeKey(Nodes[A].Key, Nodes[B].Key);
+        return Compare != 0 ? Compare < 0 : A < B;
+    });
+    TLayoutArray<int32> SlotOfNode;
+    SlotOfNode.SetNumUninitialized(Nodes.Num());
+    for (int32 Slot = 0; Slot < KeyOrder.Num(); ++Slot) {
+        if (Slot > 0 && KeyUtils::CompareNodeKey(Nodes[KeyOrder[Slot - 1]].Key,
+                                                 Nodes[KeyOrder[Slot]].Key) == 0) {
+            return false;
+        }
+        SlotOfNode[KeyOrder[Slot]] = Slot;
+    }
+
+    FXxHash64Builder Builder;
+    HashValue(Builder, kComponentLayoutHashVersion);
+    HashSettings(Builder, Settings);
+
+    // Hash node inputs in key order; original positions only move the anchor.
+    HashValue(Builder, Nodes.Num());
+    for (int32 NodeIndex : KeyOrder) {
+        const FLayoutNode &Node = Nodes[NodeIndex];
+        HashValue(Builder, Node.Key.Guid);
+        HashValue(Builder, Node.Size.X);
+        HashValue(Builder, Node.Size.Y);
+        HashValue(Builder, Node.bHasExecPins);
+        HashValue(Builder, Node.bIsVariableGet);
+        HashValue(Builder, Node.bIsReroute);
+        HashValue(Builder, Node.ExecInputPinCount);
+        HashValue(Builder, Node.ExecOutputPinCount);
+        HashValue(Builder, Node.InputPinCount);
+        HashValue(Builder, Node.OutputPinCount);
+    }
+
+    // Hash edges sorted by stable key so the edge list order does not matter.
+    TLayoutArray<FHashedEdge> HashedEdges;
+    HashedEdges.Reserve(Edges.Num());
+    for (const FLayoutEdge &Edge : Edges) {
+        if (!Nodes.IsValidIndex(Edge.Src) || !Nodes.IsValidIndex(Edge.Dst)) {
+            continue;
+        }
+        FHashedEdge &Hashed = HashedEdges.AddDefaulted_GetRef();
+        Hashed.StableKey = Edge.StableKey;
+        Hashed.SrcSlot = SlotOfNode[Edge.Src];
+        Hashed.DstSlot = SlotOfNode[Edge.Dst];
+        Hashed.Kind = Edge.Kind;
+        Hashed.Edge = &Edge;
+    }
+    HashedEdges.Sort([](const FHashedEdge &A, const FHashedEdge &B) {
+        if (A.StableKey != B.StableKey) {
+            return A.StableKey < B.StableKey;
+        }
+        return A.Kind < B.Kind;
+    });
+    HashValue(Builder, HashedEdges.Num());
+    for (const FHashedEdge &Hashed : HashedEdges) {
+        HashValue(Builder, Hashed.StableKey.SrcPin);
+        HashValue(Builder, Hashed.StableKey.DstPin);
+        HashValue(Builder, Hashed.SrcSlot);
+        HashValue(Builder, Hashed.DstSlot);
+        HashValue(Builder, Hashed.Kind);
+        HashName(Builder, Hashed.Edge->SrcPinName);
+        HashName(Builder, Hashed.Edge->DstPinName);
+    }
+
+    OutSignature.Hash = Builder.Finalize().Hash;
+    return true;
+}
+
+bool FindCachedComponentLayout(const FComponentLayoutSignature &Signature,
+                               FGlobalPlacement &OutPlacement)
+{
+    const TLayoutArray<int32> &KeyOrder = Signature.KeyOrder;
+    FScopeLock Lock(&GComponentLayoutCacheLock);
+    const FCachedComponentLayout *Cached =
+        GComponentLayoutCache.FindAndTouch(Signature.Hash);
+    if (!Cached || Cached->NodeCount != KeyOrder.Num() ||
+        Cached->SlotPositions.Num() != KeyOrder.Num()) {
+        return false;
+    }
+
+    // Map key slots back onto the current node indices.
+    OutPlacement = FGlobalPlacement();
+    OutPlacement.Positions.SetNumUninitialized(KeyOrder.Num());
+    for (int32 Slot = 0; Slot < KeyOrder.Num(); ++Slot) {
+        OutPlacement.Positions[KeyOrder[Slot]] = Cached->SlotPositions[Slot];
+    }
+    OutPlacement.AnchorNodeIndex =
+        Cached->AnchorSlot == INDEX_NONE ? INDEX_NONE : KeyOrder[Cached->AnchorSlot];
+    return true;
+}
+
+void StoreCachedComponentLayout(const FComponentLayoutSignature &Signature,
+                                const FGlobalPlacement &Placement)
+{
+    const TLayoutArray<int32> &KeyOrder = Signature.KeyOrder;
+    if (Placement.Positions.Num() != KeyOrder.Num()) {
+        return;
+    }
+
+    // Convert node indices to key slots before taking the lock.
+    FCachedComponentLayout Cached;
+    Cached.NodeCount = KeyOrder.Num();
+    Cached.SlotPositions.SetNumUninitialized(KeyOrder.Num());
+    for (int32 Slot = 0; Slot < KeyOrder.Num(); ++Slot) {
+        const int32 NodeIndex = KeyOrder[Slot];
+        Cached.SlotPositions[Slot] = Placement.Positions[NodeIndex];
+        if (NodeIndex == Placement.AnchorNodeIndex) {
+            Cached.AnchorSlot = Slot;
+        }
+    }
+
+    FScopeLock Lock(&GComponentLayoutCacheLock);
+    GComponentLayoutCache.Add(Signature.Hash, MoveTemp(Cached));
+}
+
+void FindPriorNodeOrders(TConstArrayView<uint64> Identities,
+                         TLayoutArray<FPriorNodeOrder> &OutOrders)
+{
+    OutOrders.Reset(Identities.Num());
+    OutOrders.AddDefaulted(Identities.Num());
+    FScopeLock Lock(&GPriorNodeOrderLock);
+    for (int32 Index = 0; Index < Identities.Num(); ++Index) {
+        const FPriorNodeOrder *Found = GPriorNodeOrders.FindAndTouch(Identities[Index]);
+        if (Found) {
+            OutOrders[Index] = *Found;
+        }
+    }
+}
+
+void StorePriorNodeOrders(TConstArrayView<uint64> Identities,
+                          TConstArrayView<FPriorNodeOrder> Orders)
+{
+    check(Identities.Num() == Orders.Num());
+    FScopeLock Lock(&GPriorNodeOrderLock);
+    for (int32 Index = 0; Index < Identities.Num(); ++Index) {
+        GPriorNodeOrders.Add(Identities[Index], Orders[Index]);
+    }
+}
+
+void ClearComponentLayoutCache()
+{
+    {
+        FScopeLock Lock(&GPriorNodeOrderLock);
+        GPriorNodeOrders.Empty(kPriorNodeOrderCapacity);
+    }
+    FScopeLock Lock(&GComponentLayoutCacheLock);
+    GComponentLayoutCache.Empty(kComponentLayoutCacheCapacity);
+    LAYOUT_LOG(Verbose, TEXT("ComponentLayoutCache: cleared"));
+}
+} // namespace GraphLayout
@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Batch auto-layout interface.
+#include "K2/K2AutoLayoutBatch.h"
+
+// Engine dependencies for graph access, threading, and package saving.
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "BlueprintAutoLayoutLog.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/PackageName.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/StrongObjectPtr.h"
+
+// Batch auto-layout implementation.
+namespace K2AutoLayout
+{
+namespace
+{
+// Loaded assets between garbage collections, so large batches stay bounded.
+constexpr int32 kAssetsPerGarbageCollection = 64;
+
+// One loaded asset moving through the load, compute, and commit stages.
+struct FAssetBatch
+{
+    TStrongObjectPtr<UBlueprint> Blueprint;
+    TArray<FAutoLayoutJob> Jobs;
+    TFuture<void> Task;
+};
+
+// Record a failure with the object it came from.
+void AddBatchError(FBatchAutoLayoutResult &OutResult, const UObject *Object,
+                   const FString &Error)
+{
+    const FString Message = FString::Printf(
+        TEXT("%s: %s"), Object ? *Object->GetPathName() : TEXT("<null>"), *Error);
+    UE_LOG(LogBlueprintAutoLayout, Warning, TEXT("AutoLayoutBatch: %s"), *Message);
+    OutResult.Errors.Add(Message);
+}
+
+// Capture one layout job per non-empty graph of the Blueprint.
+void PrepareBlueprintJobs(UBlueprint *Blueprint, const FAutoLayoutSettings &Settings,
+                          TArray<FAutoLayoutJob> &OutJobs,
+                          FBatchAutoLayoutResult &OutResult)
+{
+    TArray<UEdGraph *> Graphs;
+    CollectLayoutGraphs(Blueprint, Graphs);
+    OutJobs.Reset(Graphs.Num());
+    for (UEdGraph *Graph : Graphs) {
+        // Every island of the graph is seeded by its own nodes.
+        TArray<UEdGraphNode *> StartNodes;
+        StartNodes.Reserve(Graph->Nodes.Num());
+        for (UEdGraphNode *Node : Graph->Nodes) {
+            if (Node) {
+                StartNodes.Add(Node);
+            }
+        }
+        if (StartNodes.IsEmpty()) {
+            ++OutResult.GraphsSkipped;
+            continue;
+        }
+
+        // Batch runs never open editors; an opened editor would also keep the
+        // asset referenced past the periodic garbage collection.
+        FAutoLayoutResult PrepareResult;
+        FAutoLayoutJob &Job = OutJobs.AddDefaulted_GetRef();
+        if (!PrepareAutoLayout(Blueprint, Graph, StartNodes, Settings, Job,
+                               PrepareResult, EAutoLayoutPanelMode::ExistingOnly)) {
+            OutJobs.Pop(EAllowShrinking::No);
+            AddBatchError(OutResult, Graph, PrepareResult.Error);
+        }
+    }
+}
+
+// Apply the computed jobs and return how many nodes moved.
+int32 CommitBlueprintJobs(const TArray<FAutoLayoutJob> &Jobs,
+                          FBatchAutoLayoutResult &OutResult)
+{
+    int32 NodesMoved = 0;
+    for (const FAutoLayoutJob &Job : Jobs) {
+        FAutoLayoutResult CommitResult;
+        if (!CommitAutoLayout(Job, CommitResult)) {
+            AddBatchError(OutResult, Job.Graph.Get(), CommitResult.Error);
+            continue;
+        }
+        ++OutResult.GraphsLaidOut;
+        OutResult.NodesLaidOut += CommitResult.NodesLaidOut;
+        NodesMoved += CommitResult.NodesMoved;
+    }
+    return NodesMoved;
+}
+
+// Save the Blueprint package to its file on disk.
+bool SaveBlueprintPackage(UBlueprint *Blueprint, FBatchAutoLayoutResult &OutResult)
+{
+    UPackage *Package = Blueprint->GetOutermost();
+    const FString Filename = FPackageName::LongPackageNameToFilename(
+        Package->GetName(), FPackageName::GetAssetPackageExtension());
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    SaveArgs.SaveFlags = SAVE_NoError;
+    if (!UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs)) {
+        AddBatchError(OutResult, Blueprint, TEXT("Failed to save package."));
+        return false;
+    }
+    ++OutResult.AssetsSaved;
+    return true;
+}
+} // namespace
+
+void CollectLayoutGraphs(UBlueprint *Blueprint, TArray<UEdGraph *> &OutGraphs)
+{
+    OutGraphs.Reset();
+    if (!Blueprint) {
+        return;
+    }
+
+    // Keep only graphs the layout can edit; GetAllGraphs also returns sub-graphs.
+    TArray<UEdGraph *> AllGraphs;
+    Blueprint->GetAllGraphs(AllGraphs);
+    for (UEdGraph *Graph : AllGraphs) {
+        if (!Graph || !Cast<UEdGraphSchema_K2>(Graph->GetSchema())) {
+            continue;
+        }
+        if (FBlueprintEditorUtils::IsGraphReadOnly(Graph) ||
+            FBlueprintEditorUtils::IsGraphIntermediate(Graph)) {
+            continue;
+        }
+        OutGraphs.Add(Graph);
+    }
+}
+
+bool AutoLayoutBlueprintGraphs(UBlueprint *Blueprint,
+                               const FAutoLayoutSettings &Settings,
+                               FBatchAutoLayoutResult &OutResult)
+{
+    check(IsInGameThread());
+    if (!Blueprint) {
+        AddBatchError(OutResult, nullptr, TEXT("Missing Blueprint."));
+        return false;
+    }
+    const int32 ErrorCount = OutResult.Errors.Num();
+    ++OutResult.AssetsProcessed;
+
+    // Compute graphs side by side; each job only reads its own captured input.
+    TArray<FAutoLayoutJob> Jobs;
+    PrepareBlueprintJobs(Blueprint, Settings, Jobs, OutResult);
+    ParallelFor(Jobs.Num(),
+                [&Jobs](int32 JobIndex) { ComputeAutoLayout(Jobs[JobIndex]); });
+    CommitBlueprintJobs(Jobs, OutResult);
+    return OutResult.Errors.Num() == ErrorCount;
+}
+
+bool AutoLayoutBlueprintAssets(const TArray<FSoftObjectPath> &AssetPaths,
+                               const FAutoLayoutSettings &Settings,
+                               const FBatchAutoLayoutOptions &Options,
+                               FBatchAutoLayoutResult &OutResult)
+{
+    check(IsInGameThread());
+    const int32 ErrorCount = OutResult.Errors.Num();
+    const int32 MaxInFlight = FMath::Max(1, Options.MaxAssetsInFlight);
+
+    // Commit and save the oldest asset once its compute task has finished.
+    TArray<TUniquePtr<FAssetBatch>> InFlight;
+    auto FinishOldest = [&]() {
+        TUniquePtr<FAssetBatch> Batch = MoveTemp(InFlight[0]);
+        InFlight.RemoveAt(0);
+        Batch->Task.Wait();
+        UBlueprint *Blueprint = Batch->Blueprint.Get();
+        const int32 NodesMoved = CommitBlueprintJobs(Batch->Jobs, OutResult);
+        if (Options.bSave && NodesMoved > 0) {
+            SaveBlueprintPackage(Blueprint, OutResult);
+        }
+        UE_LOG(LogBlueprintAutoLayout, Display,
+               TEXT("AutoLayoutBatch: %s graphs=%d moved=%d"),
+               *Blueprint->GetPathName(), Batch->Jobs.Num(), NodesMoved);
+    };
+
+    // Load and capture the next asset while earlier ones compute on workers.
+    int32 LoadsSinceCollection = 0;
+    for (const FSoftObjectPath &AssetPath : AssetPaths) {
+        while (InFlight.Num() >= MaxInFlight) {
+            FinishOldest();
+        }
+
+        // Release finished assets once in a while; everything in flight is drained
+        // first so no job loses its Blueprint.
+        if (++LoadsSinceCollection > kAssetsPerGarbageCollection) {
+            while (!InFlight.IsEmpty()) {
+                FinishOldest();
+            }
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            LoadsSinceCollection = 1;
+        }
+        UBlueprint *Blueprint = Cast<UBlueprint>(AssetPath.TryLoad());
+        if (!Blueprint) {
+            const FString Error =
+                FString::Printf(TEXT("%s is not a Blueprint."), *AssetPath.ToString());
+            AddBatchError(OutResult, nullptr, Error);
+            continue;
+        }
+        ++OutResult.AssetsProcessed;
+
+        // Keep the Blueprint alive until its commit; jobs only hold weak pointers.
+        TUniquePtr<FAssetBatch> Batch = MakeUnique<FAssetBatch>();
+        Batch->Blueprint.Reset(Blueprint);
+        PrepareBlueprintJobs(Blueprint, Settings, Batch->Jobs, OutResult);
+        if (Batch->Jobs.IsEmpty()) {
+            continue;
+        }
+        FAssetBatch *RawBatch = Batch.Get();
+        Batch->Task = Async(EAsyncExecution::ThreadPool, [RawBatch]() {
+            for (FAutoLayoutJob &Job : RawBatch->Jobs) {
+                ComputeAutoLayout(Job);
+            }
+        });
+        InFlight.Add(MoveTemp(Batch));
+    }
+
+    // Drain the remaining assets in load order.
+    while (!InFlight.IsEmpty()) {
+        FinishOldest();
+    }
+    return OutResult.Errors.Num() == ErrorCount;
+}
+} // namespace K2AutoLayout
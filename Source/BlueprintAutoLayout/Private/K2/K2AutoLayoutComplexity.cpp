@@ -3,11 +3,14 @@
 // Cyclomatic complexity implementation for Blueprint graphs.
 #include "K2/K2AutoLayoutComplexity.h"
 
-// Graph node and pin types used to inspect exec outputs.
+// Graph node and pin types used to inspect exec outputs, plus change hooks.
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
 #include "EdGraphSchema_K2.h"
+#include "Editor.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
 
 // Blueprint graph cyclomatic complexity helpers.
 namespace K2AutoLayout
@@ -53,70 +56,376 @@ int32 CountExecOutputPins(const UEdGraphNode *Node)
     return ExecOutputPins;
 }
 
-// Calculate cyclomatic complexity for a specific node set.
-int32 CalculateCyclomaticComplexityForNodes(const TArray<const UEdGraphNode *> &Nodes)
+// Complexity added by one node: every linked exec output past the first.
+int32 GetExecFanOut(const UEdGraphNode *Node)
 {
-    // Treat empty node sets as zero complexity.
-    if (Nodes.IsEmpty()) {
-        return 0;
+    return FMath::Max(0, CountExecOutputPins(Node) - 1);
+}
+
+// Collect the distinct nodes of Graph linked to Node through any pin.
+void GatherLinkedNodes(const UEdGraphNode *Node, const UEdGraph *Graph,
+                       TArray<const UEdGraphNode *> &OutNodes)
+{
+    OutNodes.Reset();
+    for (const UEdGraphPin *Pin : Node->Pins) {
+        if (!Pin) {
+            continue;
+        }
+        for (const UEdGraphPin *LinkedPin : Pin->LinkedTo) {
+            if (!LinkedPin) {
+                continue;
+            }
+            const UEdGraphNode *LinkedNode = LinkedPin->GetOwningNode();
+            if (!LinkedNode || LinkedNode == Node || LinkedNode->GetGraph() != Graph) {
+                continue;
+            }
+            OutNodes.AddUnique(LinkedNode);
+        }
     }
+}
 
-    // Start from one to represent the base execution path.
-    int32 Complexity = 1;
+// Per-node fan-out terms and a union-find island map for one graph, kept current
+// from graph change notifications and node modifications. Adding nodes and links
+// only merges islands, so those updates are incremental. Union-find cannot split an
+// island, so removing a link or a linked node marks the index stale and the next
+// query rebuilds it.
+class FGraphComplexityIndex
+{
+  public:
+    explicit FGraphComplexityIndex(UEdGraph *InGraph) : Graph(InGraph)
+    {
+        GraphChangedHandle =
+            InGraph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateRaw(
+                this, &FGraphComplexityIndex::HandleGraphChanged));
+    }
 
-    // Add fan-out contributions from each node's exec outputs.
-    for (const UEdGraphNode *Node : Nodes) {
-        const int32 ExecOutPins = CountExecOutputPins(Node);
-        Complexity += FMath::Max(0, ExecOutPins - 1);
+    ~FGraphComplexityIndex()
+    {
+        if (UEdGraph *LiveGraph = Graph.Get()) {
+            LiveGraph->RemoveOnGraphChangedHandler(GraphChangedHandle);
+        }
     }
 
-    // Return the computed complexity.
-    return Complexity;
-}
+    const UEdGraph *GetGraph() const
+    {
+        return Graph.Get();
+    }
 
-// Gather nodes connected by pin links into a component.
-void GatherConnectedNodes(const UEdGraphNode *Seed, const UEdGraph *Graph,
-                          TSet<const UEdGraphNode *> &Visited,
-                          TArray<const UEdGraphNode *> &OutComponentNodes)
-{
-    // Guard against invalid inputs.
-    if (!Seed || !Graph) {
-        return;
+    // Complexity of the whole graph: one base path plus every node's fan-out.
+    int32 GetGraphComplexity()
+    {
+        Refresh();
+        return 1 + TotalFanOut;
     }
 
-    // Seed the traversal stack with the starting node.
-    TArray<const UEdGraphNode *> Stack;
-    Stack.Add(Seed);
-    Visited.Add(Seed);
+    // Sum of island complexities over the distinct islands holding SeedNodes.
+    int32 GetIslandComplexity(const TArray<const UEdGraphNode *> &SeedNodes)
+    {
+        Refresh();
 
-    // Walk the graph via pin links to collect the component.
-    while (!Stack.IsEmpty()) {
-        const UEdGraphNode *Current = Stack.Pop();
-        OutComponentNodes.Add(Current);
+        // Index every seed first; adding a node can merge islands seen earlier.
+        TArray<int32> SeedSlots;
+        SeedSlots.Reserve(SeedNodes.Num());
+        for (const UEdGraphNode *Node : SeedNodes) {
+            SeedSlots.Add(FindOrAddNode(Node));
+        }
 
-        // Traverse linked pins to discover neighbors.
-        for (const UEdGraphPin *Pin : Current->Pins) {
-            if (!Pin) {
-                continue;
+        // Each island counts once, however many selected nodes it holds.
+        TArray<int32> Roots;
+        Roots.Reserve(SeedSlots.Num());
+        for (int32 Slot : SeedSlots) {
+            Roots.AddUnique(FindRoot(Slot));
+        }
+        int32 TotalComplexity = 0;
+        for (int32 Root : Roots) {
+            TotalComplexity += 1 + IslandFanOut[Root];
+        }
+        return TotalComplexity;
+    }
+
+    // Force a rebuild on the next query.
+    void MarkStale()
+    {
+        bStale = true;
+    }
+
+    // Remember a node that is about to change; the next query re-reads it. Pin
+    // link edits modify both endpoint nodes before relinking, so this sees each
+    // link and unlink without a graph notification.
+    void AddPendingNode(UEdGraphNode *Node)
+    {
+        if (!bStale && Node) {
+            PendingNodes.Add(Node);
+        }
+    }
+
+    // Re-read one node's fan-out and links after it may have changed.
+    void RefreshNode(const UEdGraphNode *Node)
+    {
+        if (bStale || !Node) {
+            return;
+        }
+        const int32 *Found = SlotOfNode.Find(Node);
+        if (!Found) {
+            FindOrAddNode(Node);
+            return;
+        }
+        const int32 Slot = *Found;
+        SetFanOut(Slot, GetExecFanOut(Node));
+
+        // Any link that disappeared may have split the island.
+        TArray<const UEdGraphNode *> LinkedNodes;
+        GatherLinkedNodes(Node, Graph.Get(), LinkedNodes);
+        TArray<int32> LinkedSlots;
+        LinkedSlots.Reserve(LinkedNodes.Num());
+        for (const UEdGraphNode *LinkedNode : LinkedNodes) {
+            if (const int32 *LinkedSlot = SlotOfNode.Find(LinkedNode)) {
+                LinkedSlots.Add(*LinkedSlot);
             }
-            for (const UEdGraphPin *LinkedPin : Pin->LinkedTo) {
-                if (!LinkedPin) {
-                    continue;
-                }
-                const UEdGraphNode *LinkedNode = LinkedPin->GetOwningNode();
-                if (!LinkedNode || LinkedNode->GetGraph() != Graph) {
-                    continue;
-                }
-                if (Visited.Contains(LinkedNode)) {
-                    continue;
+        }
+        for (int32 Neighbor : Neighbors[Slot]) {
+            if (!LinkedSlots.Contains(Neighbor)) {
+                MarkStale();
+                return;
+            }
+        }
+
+        // Merge islands for new links; unindexed neighbors link back when added.
+        LinkNode(Slot, Node, LinkedNodes);
+    }
+
+  private:
+    void HandleGraphChanged(const FEdGraphEditAction &Action)
+    {
+        if (bStale) {
+            return;
+        }
+        if ((Action.Action & GRAPHACTION_RemoveNode) != 0) {
+            for (const UEdGraphNode *Node : Action.Nodes) {
+                RemoveNode(Node);
+            }
+        }
+        if ((Action.Action & (GRAPHACTION_AddNode | GRAPHACTION_EditNode)) != 0) {
+            for (const UEdGraphNode *Node : Action.Nodes) {
+                RefreshNode(Node);
+            }
+        }
+
+        // Generic notifications carry no detail about what changed; nodes edited
+        // through Modify() are already pending, and node count changes rebuild.
+        if (Action.Action == GRAPHACTION_Default) {
+            for (const UEdGraphNode *Node : Action.Nodes) {
+                RefreshNode(Node);
+            }
+        }
+        if (!bStale && Graph.IsValid()) {
+            SyncedNodeCount = Graph->Nodes.Num();
+        }
+    }
+
+    // Re-read modified nodes, then rebuild when stale or when nodes changed
+    // without a notification.
+    void Refresh()
+    {
+        const UEdGraph *LiveGraph = Graph.Get();
+        if (!LiveGraph) {
+            return;
+        }
+        if (!bStale && LiveGraph->Nodes.Num() == SyncedNodeCount) {
+            for (const TWeakObjectPtr<UEdGraphNode> &Node : PendingNodes) {
+                const UEdGraphNode *LiveNode = Node.Get();
+                if (LiveNode && LiveNode->GetGraph() == LiveGraph) {
+                    RefreshNode(LiveNode);
                 }
-                Visited.Add(LinkedNode);
-                Stack.Add(LinkedNode);
             }
+            PendingNodes.Reset();
+            if (!bStale) {
+                return;
+            }
+        }
+        PendingNodes.Reset();
+        SlotOfNode.Reset();
+        Parent.Reset();
+        IslandSize.Reset();
+        IslandFanOut.Reset();
+        FanOut.Reset();
+        Neighbors.Reset();
+        TotalFanOut = 0;
+        bStale = false;
+        for (const UEdGraphNode *Node : LiveGraph->Nodes) {
+            FindOrAddNode(Node);
+        }
+        SyncedNodeCount = LiveGraph->Nodes.Num();
+    }
+
+    // Return the slot for a node of this graph, indexing it and its links if new.
+    int32 FindOrAddNode(const UEdGraphNode *Node)
+    {
+        if (!Node) {
+            return INDEX_NONE;
+        }
+        if (const int32 *Found = SlotOfNode.Find(Node)) {
+            return *Found;
+        }
+        const int32 Slot = Parent.Add(Parent.Num());
+        const int32 NodeFanOut = GetExecFanOut(Node);
+        IslandSize.Add(1);
+        IslandFanOut.Add(NodeFanOut);
+        FanOut.Add(NodeFanOut);
+        Neighbors.AddDefaulted();
+        TotalFanOut += NodeFanOut;
+        SlotOfNode.Add(Node, Slot);
+
+        TArray<const UEdGraphNode *> LinkedNodes;
+        GatherLinkedNodes(Node, Graph.Get(), LinkedNodes);
+        LinkNode(Slot, Node, LinkedNodes);
+        return Slot;
+    }
+
+    // Record links to already indexed neighbors and merge their islands. A new
+    // link can also change the neighbor's own linked exec outputs.
+    void LinkNode(int32 Slot, const UEdGraphNode *Node,
+                  const TArray<const UEdGraphNode *> &LinkedNodes)
+    {
+        for (const UEdGraphNode *LinkedNode : LinkedNodes) {
+            const int32 *LinkedSlot = SlotOfNode.Find(LinkedNode);
+            if (!LinkedSlot || Neighbors[Slot].Contains(*LinkedSlot)) {
+                continue;
+            }
+            Neighbors[Slot].Add(*LinkedSlot);
+            Neighbors[*LinkedSlot].AddUnique(Slot);
+            Union(Slot, *LinkedSlot);
+            SetFanOut(*LinkedSlot, GetExecFanOut(LinkedNode));
+        }
+    }
+
+    // Drop a removed node; only unlinked nodes can leave without a rebuild. The
+    // node's Parent, IslandSize, and Neighbors slots stay allocated and unused
+    // until the next rebuild reclaims them.
+    void RemoveNode(const UEdGraphNode *Node)
+    {
+        const int32 *Found = SlotOfNode.Find(Node);
+        if (!Found) {
+            return;
+        }
+        const int32 Slot = *Found;
+        if (!Neighbors[Slot].IsEmpty()) {
+            MarkStale();
+            return;
+        }
+        SetFanOut(Slot, 0);
+        SlotOfNode.Remove(Node);
+    }
+
+    // Find the island root, halving the path as it goes.
+    int32 FindRoot(int32 Slot)
+    {
+        while (Parent[Slot] != Slot) {
+            Parent[Slot] = Parent[Parent[Slot]];
+            Slot = Parent[Slot];
+        }
+        return Slot;
+    }
+
+    // Merge two islands by size and combine their fan-out sums.
+    void Union(int32 A, int32 B)
+    {
+        int32 RootA = FindRoot(A);
+        int32 RootB = FindRoot(B);
+        if (RootA == RootB) {
+            return;
+        }
+        if (IslandSize[RootA] < IslandSize[RootB]) {
+            Swap(RootA, RootB);
+        }
+        Parent[RootB] = RootA;
+        IslandSize[RootA] += IslandSize[RootB];
+        IslandFanOut[RootA] += IslandFanOut[RootB];
+    }
+
+    // Replace one node's fan-out term in its island and graph totals.
+    void SetFanOut(int32 Slot, int32 NodeFanOut)
+    {
+        const int32 Delta = NodeFanOut - FanOut[Slot];
+        if (Delta == 0) {
+            return;
+        }
+        FanOut[Slot] = NodeFanOut;
+        IslandFanOut[FindRoot(Slot)] += Delta;
+        TotalFanOut += Delta;
+    }
+
+    TWeakObjectPtr<UEdGraph> Graph;
+    FDelegateHandle GraphChangedHandle;
+    TMap<TObjectKey<UEdGraphNode>, int32> SlotOfNode;
+    TArray<int32> Parent;
+    TArray<int32> IslandSize;
+    TArray<int32> IslandFanOut;
+    TArray<int32> FanOut;
+    TArray<TArray<int32>> Neighbors;
+    TSet<TWeakObjectPtr<UEdGraphNode>> PendingNodes;
+    int32 TotalFanOut = 0;
+    int32 SyncedNodeCount = 0;
+    bool bStale = true;
+};
+
+// Indices for every graph queried so far; editor menus query on the game thread.
+TMap<TObjectKey<UEdGraph>, TUniquePtr<FGraphComplexityIndex>> GComplexityIndices;
+
+// Editor hooks that catch edits made without a graph notification.
+FDelegateHandle GComplexityPropertyChangedHandle;
+FDelegateHandle GComplexityObjectModifiedHandle;
+FDelegateHandle GComplexityPostUndoRedoHandle;
+
+// Find the index for a graph, subscribing to the graph on first use.
+FGraphComplexityIndex &FindOrCreateComplexityIndex(const UEdGraph *Graph)
+{
+    const TObjectKey<UEdGraph> GraphKey(Graph);
+    if (TUniquePtr<FGraphComplexityIndex> *Found = GComplexityIndices.Find(GraphKey)) {
+        return **Found;
+    }
+
+    // Drop indices of graphs destroyed since the last new subscription.
+    for (auto It = GComplexityIndices.CreateIterator(); It; ++It) {
+        if (!It->Value->GetGraph()) {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Subscribing needs a mutable graph but does not change its content.
+    UEdGraph *MutableGraph = const_cast<UEdGraph *>(Graph);
+    return *GComplexityIndices.Add(GraphKey,
+                                   MakeUnique<FGraphComplexityIndex>(MutableGraph));
+}
+
+// Find the index of the graph that owns Node, if that graph was queried.
+FGraphComplexityIndex *FindNodeComplexityIndex(const UEdGraphNode *Node)
+{
+    const TObjectKey<UEdGraph> GraphKey(Node->GetGraph());
+    TUniquePtr<FGraphComplexityIndex> *Found = GComplexityIndices.Find(GraphKey);
+    return Found ? Found->Get() : nullptr;
+}
+
+// Refresh nodes edited through their properties.
+void HandleObjectPropertyChanged(UObject *Object, FPropertyChangedEvent &Event)
+{
+    if (const UEdGraphNode *Node = Cast<UEdGraphNode>(Object)) {
+        if (FGraphComplexityIndex *Index = FindNodeComplexityIndex(Node)) {
+            Index->RefreshNode(Node);
+        }
+    }
+}
+
+// Schema link edits call Modify() on both endpoint nodes and then report only a
+// Blueprint modification; queue the endpoints so the next query refreshes them.
+void HandleObjectModified(UObject *Object)
+{
+    if (UEdGraphNode *Node = Cast<UEdGraphNode>(Object)) {
+        if (FGraphComplexityIndex *Index = FindNodeComplexityIndex(Node)) {
+            Index->AddPendingNode(Node);
         }
     }
 }
-} // namespace
 
 // Calculate cyclomatic complexity using linked exec output fan-out.
 int32 CalculateCyclomaticComplexity(const UEdGraph *Graph)
@@ -126,17 +435,8 @@ int32 CalculateCyclomaticComplexity(const UEdGraph *Graph)
         return 0;
     }
 
-    // Start from one to represent the base execution path.
-    int32 Complexity = 1;
-
-    // Add fan-out contributions from each node's exec outputs.
-    for (const UEdGraphNode *Node : Graph->Nodes) {
-        const int32 ExecOutPins = CountExecOutputPins(Node);
-        Complexity += FMath::Max(0, ExecOutPins - 1);
-    }
-
-    // Return the computed complexity.
-    return Complexity;
+    // Read the maintained total from the graph's index.
+    return FindOrCreateComplexityIndex(Graph).GetGraphComplexity();
 }
 
 // Calculate cyclomatic complexity for islands touched by a selection.
@@ -163,22 +463,42 @@ int32 CalculateCyclomaticComplexityForSelectionIslands(
         return 0;
     }
 
-    // Walk each connected component touched by the selection.
-    TSet<const UEdGraphNode *> Visited;
-    Visited.Reserve(SeedNodes.Num());
-    int32 TotalComplexity = 0;
-    for (const UEdGraphNode *Seed : SeedNodes) {
-        if (!Seed || Visited.Contains(Seed)) {
-            continue;
-        }
+    // Sum the maintained island terms for the islands touched by the selection.
+    return FindOrCreateComplexityIndex(Graph).GetIslandComplexity(SeedNodes);
+}
 
-        // Traverse the component starting from this seed.
-        TArray<const UEdGraphNode *> ComponentNodes;
-        GatherConnectedNodes(Seed, Graph, Visited, ComponentNodes);
-        TotalComplexity += CalculateCyclomaticComplexityForNodes(ComponentNodes);
+// Undo and redo restore nodes without Modify(); rebuild every index lazily.
+void HandlePostUndoRedo()
+{
+    for (TPair<TObjectKey<UEdGraph>, TUniquePtr<FGraphComplexityIndex>> &Pair :
+         GComplexityIndices) {
+        Pair.Value->MarkStale();
     }
+}
+} // namespace
 
-    // Return the aggregated complexity.
-    return TotalComplexity;
+// Register the editor hooks shared by every complexity index.
+void StartupComplexityIndex()
+{
+    GComplexityPropertyChangedHandle =
+        FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(
+            &HandleObjectPropertyChanged);
+    GComplexityObjectModifiedHandle =
+        FCoreUObjectDelegates::OnObjectModified.AddStatic(&HandleObjectModified);
+    GComplexityPostUndoRedoHandle =
+        FEditorDelegates::PostUndoRedo.AddStatic(&HandlePostUndoRedo);
+}
+
+// Unsubscribe from indexed graphs and release the indices.
+void ShutdownComplexityIndex()
+{
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(
+        GComplexityPropertyChangedHandle);
+    GComplexityPropertyChangedHandle.Reset();
+    FCoreUObjectDelegates::OnObjectModified.Remove(GComplexityObjectModifiedHandle);
+    GComplexityObjectModifiedHandle.Reset();
+    FEditorDelegates::PostUndoRedo.Remove(GComplexityPostUndoRedoHandle);
+    GComplexityPostUndoRedoHandle.Reset();
+    GComplexityIndices.Empty();
 }
 } // namespace K2AutoLayout
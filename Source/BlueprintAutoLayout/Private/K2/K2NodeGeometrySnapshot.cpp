@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Node geometry snapshot interface.
+#include "K2/K2NodeGeometrySnapshot.h"
+
+// Editor dependencies for widget traversal and size caching.
+#include "EdGraph/EdGraphNode.h"
+#include "K2/K2NodeSizeCache.h"
+#include "SGraphNode.h"
+#include "SGraphPanel.h"
+
+// Node geometry snapshot implementation.
+namespace K2AutoLayout
+{
+namespace
+{
+// Check whether both axes are large enough to be real widget geometry.
+bool IsUsableSize(const FVector2f &Size)
+{
+    return Size.X > KINDA_SMALL_NUMBER && Size.Y > KINDA_SMALL_NUMBER;
+}
+} // namespace
+
+// Look the node up by GUID and reject entries owned by a different node.
+const FNodeGeometrySnapshot::FNode *
+FNodeGeometrySnapshot::Find(const UEdGraphNode *Node) const
+{
+    if (!Node || !Node->NodeGuid.IsValid()) {
+        return nullptr;
+    }
+    const int32 *Index = NodeIndexByGuid.Find(Node->NodeGuid);
+    if (!Index || Nodes[*Index].Node != Node) {
+        return nullptr;
+    }
+    return &Nodes[*Index];
+}
+
+// Walk the panel's node widgets once instead of resolving each node by GUID.
+void CaptureNodeGeometry(SGraphPanel &Panel, const TSet<UEdGraphNode *> &Nodes,
+                         FNodeGeometrySnapshot &OutSnapshot)
+{
+    OutSnapshot.Nodes.Reset();
+    OutSnapshot.NodeIndexByGuid.Reset();
+
+    // Every child of a graph panel is a node widget.
+    FChildren *Children = Panel.GetChildren();
+    if (!Children || Nodes.IsEmpty()) {
+        return;
+    }
+    OutSnapshot.Nodes.Reserve(Nodes.Num());
+    OutSnapshot.NodeIndexByGuid.Reserve(Nodes.Num());
+
+    // Stop walking once every requested node has been captured.
+    const int32 NumChildren = Children->Num();
+    for (int32 ChildIndex = 0;
+         ChildIndex < NumChildren && OutSnapshot.Nodes.Num() < Nodes.Num();
+         ++ChildIndex) {
+        const TSharedRef<SGraphNode> NodeWidget =
+            StaticCastSharedRef<SGraphNode>(Children->GetChildAt(ChildIndex));
+        UEdGraphNode *Node = NodeWidget->GetNodeObj();
+        if (!Node || !Nodes.Contains(Node) || !Node->NodeGuid.IsValid() ||
+            OutSnapshot.NodeIndexByGuid.Contains(Node->NodeGuid)) {
+            continue;
+        }
+
+        // Read both sizes; the cached geometry is empty until the panel has painted.
+        FNodeGeometrySnapshot::FNode Entry;
+        Entry.Node = Node;
+        Entry.PinSignature = ComputeNodePinSignature(Node);
+        Entry.AbsoluteSize = NodeWidget->GetCachedGeometry().GetAbsoluteSize();
+        Entry.DesiredSize = FVector2f(NodeWidget->GetDesiredSize());
+        const bool bHasAbsoluteSize = IsUsableSize(Entry.AbsoluteSize);
+        const bool bHasDesiredSize = IsUsableSize(Entry.DesiredSize);
+        if (bHasAbsoluteSize || bHasDesiredSize) {
+            const FVector2f Absolute =
+                bHasAbsoluteSize ? Entry.AbsoluteSize : FVector2f::ZeroVector;
+            const FVector2f Desired =
+                bHasDesiredSize ? Entry.DesiredSize : FVector2f::ZeroVector;
+            Entry.Size = FVector2f::Max(Absolute, Desired);
+        }
+
+        OutSnapshot.NodeIndexByGuid.Add(Node->NodeGuid, OutSnapshot.Nodes.Num());
+        OutSnapshot.Nodes.Add(Entry);
+    }
+}
+
+// Record the measured entries in one pass over the snapshot.
+void RecordMeasuredNodeSizes(const FNodeGeometrySnapshot &Snapshot)
+{
+    for (const FNodeGeometrySnapshot::FNode &Entry : Snapshot.Nodes) {
+        if (IsUsableSize(Entry.Size)) {
+            RecordMeasuredNodeSize(Entry.Node, Entry.PinSignature, Entry.Size);
+        }
+    }
+}
+} // namespace K2AutoLayout
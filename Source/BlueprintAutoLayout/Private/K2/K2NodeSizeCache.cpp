@@ -0,0 +1,326 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Node size cache interface.
+#include "K2/K2NodeSizeCache.h"
+
+// Engine dependencies for node inspection, persistence, and invalidation hooks.
+#include "BlueprintAutoLayoutLog.h"
+#include "Containers/LruCache.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+// Node size cache implementation.
+namespace K2AutoLayout
+{
+namespace
+{
+// Bounds for the in-memory caches; least recently used entries are evicted first.
+constexpr int32 kNodeSizeCacheCapacity = 8192;
+constexpr int32 kNodeSizeEstimateCapacity = 2048;
+
+// File format tags for the persisted estimate table.
+constexpr uint32 kNodeSizeEstimateMagic = 0x534C4142;
+constexpr int32 kNodeSizeEstimateVersion = 1;
+
+// Cache key for per-graph node size lookup.
+struct FNodeSizeCacheKey
+{
+    FObjectKey GraphKey;
+    FGuid NodeGuid;
+
+    // Allow default construction for map storage.
+    FNodeSizeCacheKey() = default;
+    FNodeSizeCacheKey(const UEdGraph *Graph, const FGuid &Guid)
+        : GraphKey(Graph), NodeGuid(Guid)
+    {
+    }
+
+    // Compare cache keys by graph and GUID.
+    bool operator==(const FNodeSizeCacheKey &Other) const
+    {
+        return GraphKey == Other.GraphKey && NodeGuid == Other.NodeGuid;
+    }
+};
+
+// Hash helper for FNodeSizeCacheKey so it can be used in hashed containers.
+uint32 GetTypeHash(const FNodeSizeCacheKey &Key)
+{
+    return HashCombine(GetTypeHash(Key.GraphKey), GetTypeHash(Key.NodeGuid));
+}
+
+// Measured size of a node instance together with the pins it was measured with.
+struct FCachedNodeSize
+{
+    FVector2f Size = FVector2f::ZeroVector;
+    uint32 PinSignature = 0;
+};
+
+// Estimate key shared by every node with the same class and pin layout.
+struct FNodeSizeEstimateKey
+{
+    FString ClassPath;
+    uint32 PinSignature = 0;
+
+    // Compare estimate keys by class path and signature.
+    bool operator==(const FNodeSizeEstimateKey &Other) const
+    {
+        return PinSignature == Other.PinSignature && ClassPath == Other.ClassPath;
+    }
+};
+
+// Hash helper for FNodeSizeEstimateKey so it can be used in hashed containers.
+uint32 GetTypeHash(const FNodeSizeEstimateKey &Key)
+{
+    return HashCombine(GetTypeHash(Key.ClassPath), Key.PinSignature);
+}
+
+using FNodeSizeEstimateCache = TLruCache<FNodeSizeEstimateKey, FVector2f>;
+
+// Last measured sizes per node instance.
+TLruCache<FNodeSizeCacheKey, FCachedNodeSize> GNodeSizeCache(kNodeSizeCacheCapacity);
+
+// Measured sizes per node class and pin signature, persisted across sessions.
+FNodeSizeEstimateCache GNodeSizeEstimates(kNodeSizeEstimateCapacity);
+bool GNodeSizeEstimatesDirty = false;
+
+// Property-change hook used to invalidate edited nodes.
+FDelegateHandle GObjectPropertyChangedHandle;
+
+// Build the estimate key for a node.
+FNodeSizeEstimateKey MakeEstimateKey(const UEdGraphNode *Node, uint32 PinSignature)
+{
+    FNodeSizeEstimateKey Key;
+    Key.ClassPath = Node->GetClass()->GetPathName();
+    Key.PinSignature = PinSignature;
+    return Key;
+}
+
+// Reject sizes that cannot be used for layout.
+bool IsUsableSize(const FVector2f &Size)
+{
+    return Size.X > KINDA_SMALL_NUMBER && Size.Y > KINDA_SMALL_NUMBER;
+}
+
+// Resolve the estimate table location under the project Saved directory.
+FString GetNodeSizeEstimatePath()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("BlueprintAutoLayout"),
+                           TEXT("NodeSizeEstimates.bin"));
+}
+
+// Load persisted estimates, ignoring missing or incompatible files.
+void LoadNodeSizeEstimates()
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *GetNodeSizeEstimatePath(),
+                                      FILEREAD_Silent)) {
+        return;
+    }
+
+    // Validate the header before reading entries.
+    FMemoryReader Reader(Bytes);
+    uint32 Magic = 0;
+    int32 Version = 0;
+    int32 Count = 0;
+    Reader << Magic << Version << Count;
+    if (Reader.IsError() || Magic != kNodeSizeEstimateMagic ||
+        Version != kNodeSizeEstimateVersion || Count < 0) {
+        UE_LOG(LogBlueprintAutoLayout, Verbose,
+               TEXT("NodeSizeCache: ignoring incompatible estimate file"));
+        return;
+    }
+
+    // Entries are stored most recent first; add them in reverse to keep recency.
+    TArray<TPair<FNodeSizeEstimateKey, FVector2f>> Entries;
+    Entries.Reserve(FMath::Min(Count, kNodeSizeEstimateCapacity));
+    for (int32 Index = 0; Index < Count && !Reader.IsError(); ++Index) {
+        TPair<FNodeSizeEstimateKey, FVector2f> Entry;
+        Reader << Entry.Key.ClassPath << Entry.Key.PinSignature << Entry.Value;
+        if (!Reader.IsError() && IsUsableSize(Entry.Value)) {
+            Entries.Add(MoveTemp(Entry));
+        }
+    }
+    if (Reader.IsError()) {
+        UE_LOG(LogBlueprintAutoLayout, Verbose,
+               TEXT("NodeSizeCache: estimate file is truncated"));
+        return;
+    }
+    for (int32 Index = Entries.Num() - 1; Index >= 0; --Index) {
+        GNodeSizeEstimates.Add(Entries[Index].Key, Entries[Index].Value);
+    }
+    UE_LOG(LogBlueprintAutoLayout, Verbose, TEXT("NodeSizeCache: loaded %d estimates"),
+           GNodeSizeEstimates.Num());
+}
+
+// Save estimates when they changed during this session.
+void SaveNodeSizeEstimates()
+{
+    if (!GNodeSizeEstimatesDirty) {
+        return;
+    }
+
+    // Write the header followed by entries from most to least recent.
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    uint32 Magic = kNodeSizeEstimateMagic;
+    int32 Version = kNodeSizeEstimateVersion;
+    int32 Count = GNodeSizeEstimates.Num();
+    Writer << Magic << Version << Count;
+    for (FNodeSizeEstimateCache::TConstIterator It(GNodeSizeEstimates); It; ++It) {
+        FNodeSizeEstimateKey Key = It.Key();
+        FVector2f Size = It.Value();
+        Writer << Key.ClassPath << Key.PinSignature << Size;
+    }
+    if (!FFileHelper::SaveArrayToFile(Bytes, *GetNodeSizeEstimatePath())) {
+        UE_LOG(LogBlueprintAutoLayout, Warning,
+               TEXT("NodeSizeCache: failed to save estimates to %s"),
+               *GetNodeSizeEstimatePath());
+        return;
+    }
+    GNodeSizeEstimatesDirty = false;
+}
+
+// Invalidate cached sizes for nodes whose properties were edited.
+void HandleObjectPropertyChanged(UObject *Object, FPropertyChangedEvent &Event)
+{
+    if (const UEdGraphNode *Node = Cast<UEdGraphNode>(Object)) {
+        InvalidateCachedNodeSize(Node);
+    }
+}
+} // namespace
+
+// Hash every visible pin so pin edits and reconstruction with new pins are detected.
+uint32 ComputeNodePinSignature(const UEdGraphNode *Node)
+{
+    if (!Node) {
+        return 0;
+    }
+
+    // Fold the advanced-pin display state first; it changes which pins are shown.
+    uint32 Signature = 0;
+    const uint8 AdvancedPinDisplay = static_cast<uint8>(Node->AdvancedPinDisplay);
+    Signature = FCrc::MemCrc32(&AdvancedPinDisplay, sizeof(AdvancedPinDisplay),
+                               Signature);
+    for (const UEdGraphPin *Pin : Node->Pins) {
+        if (!Pin || Pin->bHidden) {
+            continue;
+        }
+
+        // Pin identity and type drive the row layout; strings keep the hash stable
+        // across sessions.
+        const uint8 Flags[] = {static_cast<uint8>(Pin->Direction),
+                               static_cast<uint8>(Pin->PinType.ContainerType),
+                               static_cast<uint8>(Pin->bAdvancedView ? 1 : 0),
+                               static_cast<uint8>(Pin->LinkedTo.IsEmpty() ? 1 : 0)};
+        Signature = FCrc::MemCrc32(Flags, sizeof(Flags), Signature);
+        Signature = FCrc::StrCrc32(*Pin->PinName.ToString(), Signature);
+        Signature = FCrc::StrCrc32(*Pin->PinType.PinCategory.ToString(), Signature);
+        Signature = FCrc::StrCrc32(*Pin->PinType.PinSubCategory.ToString(), Signature);
+        const UObject *SubCategoryObject = Pin->PinType.PinSubCategoryObject.Get();
+        if (SubCategoryObject) {
+            Signature = FCrc::StrCrc32(*SubCategoryObject->GetPathName(), Signature);
+        }
+    }
+    return Signature;
+}
+
+// Read the cached instance size, dropping it when the pins changed since.
+bool TryGetCachedNodeSize(const UEdGraphNode *Node, uint32 PinSignature,
+                          FVector2f &OutSize)
+{
+    if (!Node || !Node->GetGraph() || !Node->NodeGuid.IsValid()) {
+        return false;
+    }
+
+    // Lookup the cached entry for this node and refresh its recency.
+    const FNodeSizeCacheKey CacheKey(Node->GetGraph(), Node->NodeGuid);
+    const FCachedNodeSize *Found = GNodeSizeCache.FindAndTouch(CacheKey);
+    if (!Found) {
+        return false;
+    }
+    if (Found->PinSignature != PinSignature || !IsUsableSize(Found->Size)) {
+        GNodeSizeCache.Remove(CacheKey);
+        return false;
+    }
+
+    // Return the cached size.
+    OutSize = Found->Size;
+    return true;
+}
+
+// Read the class and pin-signature estimate for nodes without a measurement.
+bool TryGetEstimatedNodeSize(const UEdGraphNode *Node, uint32 PinSignature,
+                             FVector2f &OutSize)
+{
+    if (!Node) {
+        return false;
+    }
+    const FVector2f *Found =
+        GNodeSizeEstimates.FindAndTouch(MakeEstimateKey(Node, PinSignature));
+    if (!Found || !IsUsableSize(*Found)) {
+        return false;
+    }
+    OutSize = *Found;
+    return true;
+}
+
+// Record the latest valid measurement for both the instance and its estimate key.
+void RecordMeasuredNodeSize(const UEdGraphNode *Node, uint32 PinSignature,
+                            const FVector2f &Size)
+{
+    // Skip invalid inputs and non-positive sizes so we only cache usable geometry.
+    if (!Node || !Node->GetGraph() || !Node->NodeGuid.IsValid() ||
+        !IsUsableSize(Size)) {
+        return;
+    }
+
+    // Replace the instance entry with the current measurement.
+    FCachedNodeSize Entry;
+    Entry.Size = Size;
+    Entry.PinSignature = PinSignature;
+    GNodeSizeCache.Add(FNodeSizeCacheKey(Node->GetGraph(), Node->NodeGuid), Entry);
+
+    // Update the shared estimate and mark it for saving when it changed.
+    const FNodeSizeEstimateKey EstimateKey = MakeEstimateKey(Node, PinSignature);
+    const FVector2f *Existing = GNodeSizeEstimates.FindAndTouch(EstimateKey);
+    if (!Existing || !Existing->Equals(Size, KINDA_SMALL_NUMBER)) {
+        GNodeSizeEstimates.Add(EstimateKey, Size);
+        GNodeSizeEstimatesDirty = true;
+    }
+}
+
+// Forget the measured size of a single node instance.
+void InvalidateCachedNodeSize(const UEdGraphNode *Node)
+{
+    if (!Node || !Node->GetGraph() || !Node->NodeGuid.IsValid()) {
+        return;
+    }
+    GNodeSizeCache.Remove(FNodeSizeCacheKey(Node->GetGraph(), Node->NodeGuid));
+}
+
+// Load estimates and register the invalidation hook.
+void StartupNodeSizeCache()
+{
+    LoadNodeSizeEstimates();
+    GObjectPropertyChangedHandle =
+        FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(
+            &HandleObjectPropertyChanged);
+}
+
+// Persist estimates and release cached state.
+void ShutdownNodeSizeCache()
+{
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(GObjectPropertyChangedHandle);
+    GObjectPropertyChangedHandle.Reset();
+    SaveNodeSizeEstimates();
+    GNodeSizeCache.Empty(kNodeSizeCacheCapacity);
+}
+} // namespace K2AutoLayout
@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types and commandlet base.
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+// Generated commandlet definition.
+#include "BlueprintAutoLayoutBenchmarkCommandlet.generated.h"
+
+// Headless layout benchmark over generated graphs.
+//
+// Usage: UnrealEditor-Cmd <Project> -run=BlueprintAutoLayoutBenchmark
+//        [-Shapes=ExecChain+Mixed] [-Sizes=10+100+1000] [-Iterations=N]
+//        [-Seed=N] [-Golden=<file>] [-WriteGolden]
+//        [-Replay=<capture>+<capture>]
+//
+// Each shape runs at each size with default layout settings, so timings and output
+// hashes do not depend on project configuration. -Golden compares the hashes with
+// a file of "Shape,Nodes,Seed,Hash" lines; -WriteGolden rewrites that file instead.
+// -Replay times files saved by BlueprintAutoLayout.Capture.Next with the settings
+// they recorded instead of generated graphs; their golden keys use "replay" as the
+// seed.
+// Returns non-zero when a layout fails, is nondeterministic, or misses its hash.
+UCLASS()
+class UBlueprintAutoLayoutBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+  public:
+    UBlueprintAutoLayoutBenchmarkCommandlet();
+
+    // Run the benchmark with the parsed command line.
+    virtual int32 Main(const FString &Params) override;
+};
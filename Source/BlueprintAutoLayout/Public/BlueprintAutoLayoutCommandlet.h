@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types and commandlet base.
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+// Generated commandlet definition.
+#include "BlueprintAutoLayoutCommandlet.generated.h"
+
+// Headless batch layout of every graph in a set of Blueprint assets.
+//
+// Usage: UnrealEditor-Cmd <Project> -run=BlueprintAutoLayout
+//        [-Paths=/Game/A+/Game/B] [-Assets=/Game/X.X+/Game/Y.Y] [-NoSave]
+//        [-MaxInFlight=N]
+//
+// -Paths scans package paths recursively for Blueprints; -Assets names objects
+// directly. Layout uses the project's auto-layout settings. Returns non-zero when
+// any asset or graph failed.
+UCLASS()
+class UBlueprintAutoLayoutCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+  public:
+    UBlueprintAutoLayoutCommandlet();
+
+    // Run the batch with the parsed command line.
+    virtual int32 Main(const FString &Params) override;
+};
@@ -15,6 +15,22 @@ enum class EBlueprintAutoLayoutRankAlignment : uint8
     Right UMETA(DisplayName = "Right")
 };
 
+// Engines that assign coordinates within each column.
+UENUM()
+enum class EBlueprintAutoLayoutPlacement : uint8
+{
+    Compact UMETA(DisplayName = "Compact Constraints"),
+    BrandesKoepf UMETA(DisplayName = "Brandes-Koepf")
+};
+
+// Node ordering heuristics used by crossing reduction.
+UENUM()
+enum class EBlueprintAutoLayoutCrossingReduction : uint8
+{
+    Barycenter UMETA(DisplayName = "Barycenter Sweeps"),
+    MedianTranspose UMETA(DisplayName = "Median + Transpose")
+};
+
 // Default values for auto-layout settings.
 namespace BlueprintAutoLayout
 {
@@ -36,5 +52,34 @@ inline constexpr EBlueprintAutoLayoutRankAlignment DefaultVariableGetRankAlignme
 inline constexpr bool DefaultPlaceVariableGetUnderDestination = false;
 inline constexpr int32 DefaultVariableGetMinLength = 1;
 inline constexpr bool DefaultAlignExecChainsHorizontally = true;
+inline constexpr EBlueprintAutoLayoutPlacement DefaultPlacement =
+    EBlueprintAutoLayoutPlacement::Compact;
+
+// Crossing reduction defaults.
+inline constexpr bool DefaultAdaptiveCrossingReduction = false;
+inline constexpr int32 DefaultMaxAdaptiveCrossingSweeps = 32;
+inline constexpr bool DefaultVirtualLongEdgeChains = false;
+inline constexpr EBlueprintAutoLayoutCrossingReduction DefaultCrossingReduction =
+    EBlueprintAutoLayoutCrossingReduction::Barycenter;
+inline constexpr int32 DefaultCrossingReductionMaxIterations = 24;
+inline constexpr float DefaultCrossingReductionTimeBudgetMs = 0.0f;
+
+// Lane/junction coarsening defaults.
+inline constexpr bool DefaultCoarsenExecLanes = false;
+inline constexpr int32 DefaultCoarsenExecLanesMinNodes = 5000;
+
+// Result cache defaults.
+inline constexpr bool DefaultCacheComponentLayouts = true;
+inline constexpr bool DefaultIncrementalLayout = false;
+
+// Editor execution defaults.
+inline constexpr bool DefaultBackgroundLayout = true;
+inline constexpr int32 DefaultBackgroundLayoutMinNodes = 1000;
+
+// Live layout defaults.
+inline constexpr bool DefaultLiveLayout = false;
+inline constexpr float DefaultLiveLayoutFrameBudgetMs = 4.0f;
+inline constexpr float DefaultLiveLayoutDebounceSeconds = 0.3f;
+inline constexpr int32 DefaultLiveLayoutBackgroundMinNodes = 200;
 } // namespace Defaults
 } // namespace BlueprintAutoLayout
@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types and function library base.
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+// Generated library definition.
+#include "BlueprintAutoLayoutLibrary.generated.h"
+
+// Forward declaration for Blueprint inputs.
+class UBlueprint;
+
+// Auto layout entry points for Python and editor utility scripts.
+UCLASS()
+class BLUEPRINTAUTOLAYOUT_API UBlueprintAutoLayoutLibrary
+    : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+  public:
+    // Lay out every graph of a loaded Blueprint with the project settings.
+    UFUNCTION(BlueprintCallable, Category = "Blueprint Auto Layout")
+    static bool AutoLayoutBlueprint(UBlueprint *Blueprint, int32 &NodesLaidOut,
+                                    FString &Error);
+
+    // Load, lay out, and optionally save Blueprint assets by object path.
+    UFUNCTION(BlueprintCallable, Category = "Blueprint Auto Layout")
+    static bool AutoLayoutBlueprintAssets(const TArray<FSoftObjectPath> &Assets,
+                                          bool bSave, int32 &NodesLaidOut,
+                                          FString &Error);
+};
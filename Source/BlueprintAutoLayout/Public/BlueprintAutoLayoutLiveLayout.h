@@ -0,0 +1,18 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for API exposure.
+#include "CoreMinimal.h"
+
+// Live layout of edited graphs.
+namespace BlueprintAutoLayout
+{
+// While the Live Layout setting is on, re-lay out the islands around nodes whose
+// links changed (pasted, spawned, or relinked nodes) in graphs open in an editor.
+// Edits are debounced, layout runs from an editor ticker within a per-frame budget,
+// and work in flight is discarded when its graph is edited again.
+void StartupLiveLayout();
+void ShutdownLiveLayout();
+} // namespace BlueprintAutoLayout
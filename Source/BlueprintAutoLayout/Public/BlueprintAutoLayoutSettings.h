@@ -69,12 +69,148 @@ class BLUEPRINTAUTOLAYOUT_API UBlueprintAutoLayoutSettings : public UDeveloperSe
                       EditConditionHides))
     EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment =
         BlueprintAutoLayout::Defaults::DefaultVariableGetRankAlignment;
+    UPROPERTY(EditAnywhere, config, Category = "Placement",
+              meta = (DisplayName = "Placement Engine",
+                      ToolTip = "Compact relaxes spacing constraints. Brandes-Koepf "
+                                "aligns nodes with their neighbors in linear time, "
+                                "keeping exec chains straight on deep graphs."))
+    EBlueprintAutoLayoutPlacement Placement =
+        BlueprintAutoLayout::Defaults::DefaultPlacement;
     UPROPERTY(EditAnywhere, config, Category = "Placement",
               meta = (DisplayName = "Align Exec Chains Horizontally",
-                      ToolTip = "Align exec chains to be as horizontal as possible."))
+                      ToolTip = "Align exec chains to be as horizontal as possible.",
+                      EditCondition =
+                          "Placement == EBlueprintAutoLayoutPlacement::Compact",
+                      EditConditionHides))
     bool bAlignExecChainsHorizontally =
         BlueprintAutoLayout::Defaults::DefaultAlignExecChainsHorizontally;
 
+    // Crossing reduction tuning parameters.
+    UPROPERTY(EditAnywhere, config, Category = "Crossing Reduction",
+              meta = (DisplayName = "Adaptive Sweeps",
+                      ToolTip = "Stop crossing reduction once node orders are stable "
+                                "or the crossing count stops improving."))
+    bool bAdaptiveCrossingReduction =
+        BlueprintAutoLayout::Defaults::DefaultAdaptiveCrossingReduction;
+    UPROPERTY(EditAnywhere, config, Category = "Crossing Reduction",
+              meta = (ClampMin = "2", UIMin = "2", DisplayName = "Max Adaptive Sweeps",
+                      ToolTip = "Upper bound on sweeps when adaptive sweeps are on.",
+                      EditCondition = "bAdaptiveCrossingReduction",
+                      EditConditionHides))
+    int32 MaxAdaptiveCrossingSweeps =
+        BlueprintAutoLayout::Defaults::DefaultMaxAdaptiveCrossingSweeps;
+    UPROPERTY(EditAnywhere, config, Category = "Crossing Reduction",
+              meta = (DisplayName = "Virtual Long Edge Chains",
+                      ToolTip = "Order each long edge's dummy chain as one entity "
+                                "that follows its endpoint instead of per rank."))
+    bool bVirtualLongEdgeChains =
+        BlueprintAutoLayout::Defaults::DefaultVirtualLongEdgeChains;
+    UPROPERTY(EditAnywhere, config, Category = "Crossing Reduction",
+              meta = (DisplayName = "Ordering Heuristic",
+                      ToolTip = "Barycenter sweeps are fast. Median + Transpose "
+                                "spends more time for fewer crossings within the "
+                                "budget below."))
+    EBlueprintAutoLayoutCrossingReduction CrossingReduction =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReduction;
+    UPROPERTY(EditAnywhere, config, Category = "Crossing Reduction",
+              meta = (ClampMin = "1", UIMin = "1", UIMax = "64",
+                      DisplayName = "Max Median Iterations",
+                      ToolTip = "Median ordering rounds, each followed by adjacent "
+                                "exchanges; the best order seen is kept.",
+                      EditCondition = "CrossingReduction == "
+                                      "EBlueprintAutoLayoutCrossingReduction::"
+                                      "MedianTranspose",
+                      EditConditionHides))
+    int32 CrossingReductionMaxIterations =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReductionMaxIterations;
+    UPROPERTY(EditAnywhere, config, Category = "Crossing Reduction",
+              meta = (ClampMin = "0.0", UIMin = "0.0", DisplayName = "Time Budget (ms)",
+                      ToolTip = "Stop median rounds after this long per island; 0 "
+                                "limits them by iterations only. A time limit can "
+                                "make results differ between machines.",
+                      EditCondition = "CrossingReduction == "
+                                      "EBlueprintAutoLayoutCrossingReduction::"
+                                      "MedianTranspose",
+                      EditConditionHides))
+    float CrossingReductionTimeBudgetMs =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReductionTimeBudgetMs;
+
+    // Lane/junction coarsening parameters.
+    UPROPERTY(EditAnywhere, config, Category = "Coarsening",
+              meta = (DisplayName = "Coarsen Exec Lanes",
+                      ToolTip = "Order large islands by their exec lanes and "
+                                "junctions first, then lay out each lane on its own."))
+    bool bCoarsenExecLanes = BlueprintAutoLayout::Defaults::DefaultCoarsenExecLanes;
+    UPROPERTY(EditAnywhere, config, Category = "Coarsening",
+              meta = (ClampMin = "2", UIMin = "2",
+                      DisplayName = "Coarsen Exec Lanes Min Nodes",
+                      ToolTip = "Island node count at which lane coarsening is used.",
+                      EditCondition = "bCoarsenExecLanes", EditConditionHides))
+    int32 CoarsenExecLanesMinNodes =
+        BlueprintAutoLayout::Defaults::DefaultCoarsenExecLanesMinNodes;
+
+    // Result cache parameters.
+    UPROPERTY(EditAnywhere, config, Category = "Caching",
+              meta = (DisplayName = "Cache Component Layouts",
+                      ToolTip = "Reuse the layout of an island whose nodes, sizes, "
+                                "links, and settings are unchanged since an earlier "
+                                "run."))
+    bool bCacheComponentLayouts =
+        BlueprintAutoLayout::Defaults::DefaultCacheComponentLayouts;
+    UPROPERTY(EditAnywhere, config, Category = "Caching",
+              meta = (DisplayName = "Incremental Layout",
+                      ToolTip = "Keep the node order of the previous run and only "
+                                "reorder ranks near added, moved, or relinked "
+                                "nodes."))
+    bool bIncrementalLayout = BlueprintAutoLayout::Defaults::DefaultIncrementalLayout;
+
+    // Editor execution parameters; not part of the layout engine settings.
+    UPROPERTY(EditAnywhere, config, Category = "Execution",
+              meta = (DisplayName = "Background Layout",
+                      ToolTip = "Compute large layouts on a background thread with a "
+                                "cancelable progress notification."))
+    bool bBackgroundLayout = BlueprintAutoLayout::Defaults::DefaultBackgroundLayout;
+    UPROPERTY(EditAnywhere, config, Category = "Execution",
+              meta = (ClampMin = "0", UIMin = "0",
+                      DisplayName = "Background Layout Min Nodes",
+                      ToolTip = "Island node count at which layout moves to the "
+                                "background.",
+                      EditCondition = "bBackgroundLayout", EditConditionHides))
+    int32 BackgroundLayoutMinNodes =
+        BlueprintAutoLayout::Defaults::DefaultBackgroundLayoutMinNodes;
+
+    // Live layout parameters; editor-only like the execution parameters above.
+    UPROPERTY(EditAnywhere, config, Category = "Live Layout",
+              meta = (DisplayName = "Live Layout",
+                      ToolTip = "Re-lay out the islands around pasted, spawned, or "
+                                "relinked nodes automatically in open graphs."))
+    bool bLiveLayout = BlueprintAutoLayout::Defaults::DefaultLiveLayout;
+    UPROPERTY(EditAnywhere, config, Category = "Live Layout",
+              meta = (ClampMin = "0.5", UIMin = "0.5", UIMax = "16.0",
+                      DisplayName = "Frame Budget (ms)",
+                      ToolTip = "Layout time spent per editor frame; islands "
+                                "below the background size are laid out whole, so "
+                                "one frame may run over by up to one island.",
+                      EditCondition = "bLiveLayout", EditConditionHides))
+    float LiveLayoutFrameBudgetMs =
+        BlueprintAutoLayout::Defaults::DefaultLiveLayoutFrameBudgetMs;
+    UPROPERTY(EditAnywhere, config, Category = "Live Layout",
+              meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "2.0",
+                      DisplayName = "Debounce (s)",
+                      ToolTip = "Quiet time after the last edit before layout starts.",
+                      EditCondition = "bLiveLayout", EditConditionHides))
+    float LiveLayoutDebounceSeconds =
+        BlueprintAutoLayout::Defaults::DefaultLiveLayoutDebounceSeconds;
+    UPROPERTY(EditAnywhere, config, Category = "Live Layout",
+              meta = (ClampMin = "1", UIMin = "1",
+                      DisplayName = "Background Island Nodes",
+                      ToolTip = "Island node count at which live layout computes on "
+                                "a background thread instead of within the frame "
+                                "budget.",
+                      EditCondition = "bLiveLayout", EditConditionHides))
+    int32 LiveLayoutBackgroundMinNodes =
+        BlueprintAutoLayout::Defaults::DefaultLiveLayoutBackgroundMinNodes;
+
     // Convert editor settings to runtime layout settings.
     K2AutoLayout::FAutoLayoutSettings ToAutoLayoutSettings() const;
 };
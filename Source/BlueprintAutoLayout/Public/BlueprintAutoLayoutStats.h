@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types, stat macros, and CPU trace scopes.
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+// Stat group shown by `stat BlueprintAutoLayout`.
+DECLARE_STATS_GROUP(TEXT("BlueprintAutoLayout"), STATGROUP_BlueprintAutoLayout,
+                    STATCAT_Advanced);
+
+// Editor-side stages.
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Prepare"), STAT_BlueprintAutoLayout_Prepare,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compute"), STAT_BlueprintAutoLayout_Compute,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Commit"), STAT_BlueprintAutoLayout_Commit,
+                          STATGROUP_BlueprintAutoLayout, );
+
+// Layout engine stages, per component.
+DECLARE_CYCLE_STAT_EXTERN(TEXT("LayoutComponent"),
+                          STAT_BlueprintAutoLayout_LayoutComponent,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RemoveCycles"), STAT_BlueprintAutoLayout_RemoveCycles,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AssignLayers"), STAT_BlueprintAutoLayout_AssignLayers,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AddTerminalExecTailNodes"),
+                          STAT_BlueprintAutoLayout_ExecTails,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SplitLongEdges"),
+                          STAT_BlueprintAutoLayout_SplitLongEdges,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CrossingReduction"),
+                          STAT_BlueprintAutoLayout_CrossingReduction,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Placement"), STAT_BlueprintAutoLayout_Placement,
+                          STATGROUP_BlueprintAutoLayout, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CoarsenExecLanes"),
+                          STAT_BlueprintAutoLayout_CoarsenExecLanes,
+                          STATGROUP_BlueprintAutoLayout, );
+
+// Work counters.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes"), STAT_BlueprintAutoLayout_Nodes,
+                                  STATGROUP_BlueprintAutoLayout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dummy Nodes"), STAT_BlueprintAutoLayout_Dummies,
+                                  STATGROUP_BlueprintAutoLayout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sweeps"), STAT_BlueprintAutoLayout_Sweeps,
+                                  STATGROUP_BlueprintAutoLayout, );
+
+// Stat scope that also appears as a named event in Unreal Insights. Stat scopes
+// already emit CPU trace events, so the trace scope is only needed without stats.
+#if STATS
+#define BLUEPRINTAUTOLAYOUT_SCOPE(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define BLUEPRINTAUTOLAYOUT_SCOPE(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
+
+// Stage timing helpers.
+namespace BlueprintAutoLayout
+{
+// Add the wall time of a scope, in milliseconds, to a stats field.
+class FScopedStageTimer
+{
+  public:
+    explicit FScopedStageTimer(double &InTargetMs)
+        : TargetMs(InTargetMs), StartSeconds(FPlatformTime::Seconds())
+    {
+    }
+
+    ~FScopedStageTimer()
+    {
+        TargetMs += (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+    }
+
+  private:
+    double &TargetMs;
+    double StartSeconds;
+};
+} // namespace BlueprintAutoLayout
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types and the plugin log category.
+#include "BlueprintAutoLayoutLog.h"
+#include "CoreMinimal.h"
+
+// Atomic verbosity cache shared by layout worker threads.
+#include <atomic>
+
+// Build.cs sets this to 0 to compile layout trace output out entirely.
+#ifndef BLUEPRINTAUTOLAYOUT_TRACE
+#define BLUEPRINTAUTOLAYOUT_TRACE 1
+#endif
+
+// Layout trace facility: cached verbosity checks plus an optional ring buffer sink.
+namespace BlueprintAutoLayout
+{
+// Most verbose level that currently has a sink, cached by RefreshTraceVerbosity.
+extern BLUEPRINTAUTOLAYOUT_API std::atomic<int32> GTraceVerbosity;
+
+// Re-read the log category verbosity and the capture state. Called at the start of
+// each layout stage entry point so console verbosity changes take effect per run.
+BLUEPRINTAUTOLAYOUT_API void RefreshTraceVerbosity();
+
+// True when a trace line at Verbosity would reach the log or the capture buffer.
+inline bool IsTraceActive(ELogVerbosity::Type Verbosity)
+{
+    return static_cast<int32>(Verbosity) <=
+           GTraceVerbosity.load(std::memory_order_relaxed);
+}
+
+// Send one formatted line to the capture buffer when capturing, else to the log.
+BLUEPRINTAUTOLAYOUT_API void EmitTraceLine(ELogVerbosity::Type Verbosity,
+                                           const FString &Line);
+
+// Start capturing every trace line into a ring buffer of at most MaxLines lines.
+// While capturing, lines skip the log so large dumps cost no per-line log I/O.
+BLUEPRINTAUTOLAYOUT_API void BeginTraceCapture(int32 MaxLines);
+
+// Stop capturing and return the buffered lines, oldest first. Returns false when no
+// capture was running.
+BLUEPRINTAUTOLAYOUT_API bool EndTraceCapture(TArray<FString> &OutLines);
+} // namespace BlueprintAutoLayout
+
+// Guard for trace-only work such as building key strings or dump loops.
+// LAYOUT_LOG evaluates and formats its arguments only when the level is active, so
+// key or guid strings built inline in a call cost nothing when the line is not
+// emitted. With tracing compiled out both macros fold to constants and the
+// arguments are never evaluated.
+#if BLUEPRINTAUTOLAYOUT_TRACE
+#define LAYOUT_TRACE_ACTIVE(Verbosity)                                                 \
+    (::BlueprintAutoLayout::IsTraceActive(ELogVerbosity::Verbosity))
+#define LAYOUT_LOG(Verbosity, Format, ...)                                             \
+    do {                                                                               \
+        if (LAYOUT_TRACE_ACTIVE(Verbosity)) {                                          \
+            ::BlueprintAutoLayout::EmitTraceLine(                                      \
+                ELogVerbosity::Verbosity, FString::Printf(Format, ##__VA_ARGS__));     \
+        }                                                                              \
+    } while (false)
+#else
+#define LAYOUT_TRACE_ACTIVE(Verbosity) (false)
+#define LAYOUT_LOG(Verbosity, Format, ...)                                             \
+    do {                                                                               \
+        if constexpr (false) {                                                         \
+            (void)FString::Printf(Format, ##__VA_ARGS__);                              \
+        }                                                                              \
+    } while (false)
+#endif
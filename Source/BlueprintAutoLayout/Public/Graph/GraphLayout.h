@@ -25,6 +25,30 @@ struct BLUEPRINTAUTOLAYOUT_API FNodeKey
     FGuid Guid;
 };
 
+// Compact edge identity made of packed source and destination pin ids.
+struct BLUEPRINTAUTOLAYOUT_API FEdgeKey
+{
+    uint64 SrcPin = 0;
+    uint64 DstPin = 0;
+
+    // Compare keys as a (source, destination) tuple.
+    bool operator==(const FEdgeKey &Other) const
+    {
+        return SrcPin == Other.SrcPin && DstPin == Other.DstPin;
+    }
+    bool operator!=(const FEdgeKey &Other) const
+    {
+        return !(*this == Other);
+    }
+    bool operator<(const FEdgeKey &Other) const
+    {
+        if (SrcPin != Other.SrcPin) {
+            return SrcPin < Other.SrcPin;
+        }
+        return DstPin < Other.DstPin;
+    }
+};
+
 // Node metadata needed for layout decisions.
 struct BLUEPRINTAUTOLAYOUT_API FLayoutNode
 {
@@ -57,7 +81,23 @@ struct BLUEPRINTAUTOLAYOUT_API FLayoutEdge
     FName SrcPinName;
     FName DstPinName;
     EEdgeKind Kind = EEdgeKind::Data;
-    FString StableKey;
+
+    // Filled by the layout pass from component-local key ordinals.
+    FEdgeKey StableKey;
+};
+
+// Per-node edge adjacency in compressed sparse row form.
+struct BLUEPRINTAUTOLAYOUT_API FLayoutGraphIndex
+{
+    // Dense node id to node index lookup; ids outside the range are unknown.
+    TArray<int32> NodeIdToIndex;
+
+    // Edges touching node index I are EdgeIndices[EdgeOffsets[I], EdgeOffsets[I + 1]).
+    TArray<int32> EdgeOffsets;
+    TArray<int32> EdgeIndices;
+
+    // Edge count captured at build time to detect a stale index.
+    int32 IndexedEdgeCount = 0;
 };
 
 // Input graph container for layout.
@@ -65,6 +105,9 @@ struct BLUEPRINTAUTOLAYOUT_API FLayoutGraph
 {
     TArray<FLayoutNode> Nodes;
     TArray<FLayoutEdge> Edges;
+
+    // Optional adjacency index; when absent, component extraction scans all edges.
+    FLayoutGraphIndex Index;
 };
 
 // Settings that control spacing and placement behavior.
@@ -89,15 +132,96 @@ struct BLUEPRINTAUTOLAYOUT_API FLayoutSettings
         BlueprintAutoLayout::Defaults::DefaultVariableGetRankAlignment;
     bool bAlignExecChainsHorizontally =
         BlueprintAutoLayout::Defaults::DefaultAlignExecChainsHorizontally;
+    // Coordinate assignment engine; exec chain alignment applies to Compact only.
+    EBlueprintAutoLayoutPlacement Placement =
+        BlueprintAutoLayout::Defaults::DefaultPlacement;
+
+    // Crossing reduction schedule; fixed sweeps unless adaptive mode is enabled.
+    bool bAdaptiveCrossingReduction =
+        BlueprintAutoLayout::Defaults::DefaultAdaptiveCrossingReduction;
+    int32 MaxAdaptiveCrossingSweeps =
+        BlueprintAutoLayout::Defaults::DefaultMaxAdaptiveCrossingSweeps;
+    // Order long-edge dummy chains as single entities during sweeps.
+    bool bVirtualLongEdgeChains =
+        BlueprintAutoLayout::Defaults::DefaultVirtualLongEdgeChains;
+    // Ordering heuristic and its budget. MaxIterations bounds median rounds; a
+    // positive time budget also stops them early, at a machine-dependent point.
+    EBlueprintAutoLayoutCrossingReduction CrossingReduction =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReduction;
+    int32 CrossingReductionMaxIterations =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReductionMaxIterations;
+    float CrossingReductionTimeBudgetMs =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReductionTimeBudgetMs;
+    // Lay out lanes and junctions first, then each lane's members, on components
+    // with at least CoarsenExecLanesMinNodes nodes.
+    bool bCoarsenExecLanes = BlueprintAutoLayout::Defaults::DefaultCoarsenExecLanes;
+    int32 CoarsenExecLanesMinNodes =
+        BlueprintAutoLayout::Defaults::DefaultCoarsenExecLanesMinNodes;
+
+    // Reuse placements of structurally identical components from earlier runs.
+    bool bCacheComponentLayouts =
+        BlueprintAutoLayout::Defaults::DefaultCacheComponentLayouts;
+    // Seed orders from the previous run and re-sweep only ranks near edits.
+    bool bIncrementalLayout = BlueprintAutoLayout::Defaults::DefaultIncrementalLayout;
+};
+
+// Counters and stage wall times for one or more component layouts.
+struct BLUEPRINTAUTOLAYOUT_API FLayoutStats
+{
+    // Graph size after extraction and after long-edge splitting.
+    int32 NodeCount = 0;
+    int32 EdgeCount = 0;
+    int32 DummyCount = 0;
+    int32 ChainCount = 0;
+    int32 RankCount = 0;
+
+    // Work done by the iterative passes.
+    int32 Sweeps = 0;
+    int32 TransposeSwaps = 0;
+    int32 ConstraintVisits = 0;
+    int32 ConstraintRelaxations = 0;
+    int32 CacheHits = 0;
+
+    // Edge crossings between adjacent ranks in the final order.
+    int64 Crossings = 0;
+
+    // Stage times in milliseconds.
+    double ExtractMs = 0.0;
+    double RemoveCyclesMs = 0.0;
+    double AssignLayersMs = 0.0;
+    double ExecTailsMs = 0.0;
+    double SplitLongEdgesMs = 0.0;
+    double CrossingReductionMs = 0.0;
+    double PlacementMs = 0.0;
+    double TotalMs = 0.0;
+
+    // Sum another record into this one; ranks keep the maximum.
+    void Accumulate(const FLayoutStats &Other);
 };
 
 // Result payload for a single connected component layout.
+// NodeIds and NodePositions are index-aligned, listed in ascending node id order.
 struct BLUEPRINTAUTOLAYOUT_API FLayoutComponentResult
 {
-    TMap<int32, FVector2f> NodePositions;
+    TArray<int32> NodeIds;
+    TArray<FVector2f> NodePositions;
     FBox2f Bounds = FBox2f(EForceInit::ForceInit);
+    FLayoutStats Stats;
 };
 
+// Build the adjacency index so per-component extraction only touches its own edges.
+// Call again after editing Nodes or Edges.
+BLUEPRINTAUTOLAYOUT_API void BuildLayoutGraphIndex(FLayoutGraph &Graph);
+
+// Check that the adjacency index matches the current node and edge arrays.
+BLUEPRINTAUTOLAYOUT_API bool HasValidLayoutGraphIndex(const FLayoutGraph &Graph);
+
+// Split the graph into connected components, through the adjacency index when it is
+// valid and by scanning every edge otherwise. Components are seeded in node key
+// order and list their node ids sorted by key, as LayoutComponent expects.
+BLUEPRINTAUTOLAYOUT_API void FindLayoutComponents(const FLayoutGraph &Graph,
+                                                  TArray<TArray<int32>> &OutComponents);
+
 // Run layout for a connected component and emit node positions.
 BLUEPRINTAUTOLAYOUT_API bool LayoutComponent(const FLayoutGraph &Graph,
                                              const TArray<int32> &ComponentNodeIds,
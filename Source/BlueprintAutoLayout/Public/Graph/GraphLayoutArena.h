@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types and the thread-local linear allocator.
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+// Run-scoped storage for transient layout containers.
+namespace GraphLayout
+{
+// Transient pipeline containers allocate from the calling thread's FMemStack.
+// LayoutComponent opens an FMemMark before building any of them, and the mark
+// releases every such allocation at once when the component finishes. Parallel
+// components run on different threads and so never share an arena.
+using FLayoutArenaAllocator = TMemStackAllocator<>;
+
+// Array whose storage lives in the current layout arena. Must not outlive the
+// FMemMark that was open when it first allocated.
+template <typename T> using TLayoutArray = TArray<T, FLayoutArenaAllocator>;
+
+// Index lists per node or per rank, e.g. adjacency and rank membership.
+using FLayoutIndexLists = TLayoutArray<TLayoutArray<int32>>;
+} // namespace GraphLayout
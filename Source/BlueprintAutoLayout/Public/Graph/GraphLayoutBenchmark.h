@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for generator inputs and benchmark reports.
+#include "CoreMinimal.h"
+
+// Layout graph types and per-stage stats.
+#include "Graph/GraphLayout.h"
+
+// Synthetic graphs and headless benchmarks for the layout engine.
+namespace GraphLayout
+{
+// Blueprint-like graph shapes produced by the generator.
+enum class ESyntheticGraphShape : uint8
+{
+    // One long exec chain with occasional data links between neighbors.
+    ExecChain,
+    // Branch and sequence nodes fanning the exec flow out into a tree.
+    BranchFanOut,
+    // Exec chains with loop bodies that link back to their loop node.
+    LoopBackEdges,
+    // Exec chains fed by variable getters, some shared by several consumers.
+    VariableGetFan,
+    // Many small pure data trees with no exec pins.
+    DataIslands,
+    // Segments of every shape above in one graph.
+    Mixed
+};
+
+// Stable shape name used on command lines and in golden files.
+BLUEPRINTAUTOLAYOUT_API const TCHAR *LexToString(ESyntheticGraphShape Shape);
+
+// Parse a shape name; matching is case-insensitive.
+BLUEPRINTAUTOLAYOUT_API bool
+TryParseSyntheticGraphShape(const FString &Text, ESyntheticGraphShape &OutShape);
+
+// Generator input; equal parameters always produce the same graph.
+struct BLUEPRINTAUTOLAYOUT_API FSyntheticGraphParams
+{
+    ESyntheticGraphShape Shape = ESyntheticGraphShape::Mixed;
+    int32 NodeCount = 100;
+    int32 Seed = 1;
+};
+
+// Build a graph of about NodeCount nodes and its adjacency index.
+BLUEPRINTAUTOLAYOUT_API void GenerateSyntheticGraph(const FSyntheticGraphParams &Params,
+                                                    FLayoutGraph &OutGraph);
+
+// Hash component results by node key and rounded position, independent of their order.
+BLUEPRINTAUTOLAYOUT_API uint64
+HashLayoutResults(const FLayoutGraph &Graph,
+                  const TArray<FLayoutComponentResult> &Results);
+
+// Benchmark input: every shape is run at every size.
+struct BLUEPRINTAUTOLAYOUT_API FLayoutBenchmarkOptions
+{
+    TArray<ESyntheticGraphShape> Shapes;
+    TArray<int32> Sizes;
+    int32 Iterations = 3;
+    int32 Seed = 1;
+
+    // Layout settings; the component cache is always bypassed while timing.
+    FLayoutSettings Settings;
+};
+
+// Measurements for one shape and size, or for one replayed capture.
+struct BLUEPRINTAUTOLAYOUT_API FLayoutBenchmarkResult
+{
+    ESyntheticGraphShape Shape = ESyntheticGraphShape::Mixed;
+
+    // Capture file and its recorded label; empty for generated cases.
+    FString ReplayFile;
+    FString ReplayLabel;
+    int32 NodeCount = 0;
+    int32 EdgeCount = 0;
+    int32 Components = 0;
+
+    // Stage stats of the fastest iteration, summed over components.
+    FLayoutStats Stats;
+    double MinMs = 0.0;
+    double MedianMs = 0.0;
+
+    // Process physical memory growth across the case and the process peak after it.
+    uint64 UsedPhysicalDeltaBytes = 0;
+    uint64 PeakUsedPhysicalBytes = 0;
+
+    // Output hash and whether every iteration produced it.
+    uint64 OutputHash = 0;
+    bool bDeterministic = true;
+};
+
+// Lay out each generated case Iterations times. Returns false if any component
+// failed to lay out; results are still filled for the cases that ran.
+BLUEPRINTAUTOLAYOUT_API bool
+RunLayoutBenchmarks(const FLayoutBenchmarkOptions &Options,
+                    TArray<FLayoutBenchmarkResult> &OutResults,
+                    FString *OutError = nullptr);
+
+// Lay out each capture file (see GraphLayoutCapture.h) Iterations times with the
+// settings it recorded, minus the component cache and incremental seeding. Returns
+// false if a file fails to load or a component fails to lay out.
+BLUEPRINTAUTOLAYOUT_API bool
+RunLayoutReplays(const TArray<FString> &Filenames, int32 Iterations,
+                 TArray<FLayoutBenchmarkResult> &OutResults,
+                 FString *OutError = nullptr);
+} // namespace GraphLayout
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for capture files.
+#include "CoreMinimal.h"
+
+// Layout graph and settings definitions.
+#include "Graph/GraphLayout.h"
+
+// Capture and replay of layout engine inputs.
+namespace GraphLayout
+{
+// Everything one layout run hands to LayoutComponent. Node sizes are stored as
+// measured, so a replay does not depend on which widgets or size cache entries
+// were live when the capture was taken.
+struct BLUEPRINTAUTOLAYOUT_API FLayoutCapture
+{
+    // Free-form origin of the capture, such as the graph path.
+    FString Label;
+    FLayoutGraph Graph;
+
+    // Node ids of each component, as passed to LayoutComponent.
+    TArray<TArray<int32>> Components;
+    FLayoutSettings Settings;
+};
+
+// Write the layout input to a versioned binary file. The adjacency index is not
+// stored; loading rebuilds it.
+BLUEPRINTAUTOLAYOUT_API bool SaveLayoutCapture(const FString &Label,
+                                               const FLayoutGraph &Graph,
+                                               const TArray<TArray<int32>> &Components,
+                                               const FLayoutSettings &Settings,
+                                               const FString &Filename,
+                                               FString *OutError = nullptr);
+
+// Read a capture written by SaveLayoutCapture and rebuild its adjacency index.
+// Fails on unknown versions and truncated files.
+BLUEPRINTAUTOLAYOUT_API bool LoadLayoutCapture(const FString &Filename,
+                                               FLayoutCapture &OutCapture,
+                                               FString *OutError = nullptr);
+
+// Ask the next layout run to save its input to Filename. Set from the console with
+// BlueprintAutoLayout.Capture.Next [path].
+BLUEPRINTAUTOLAYOUT_API void RequestLayoutCapture(const FString &Filename);
+
+// Take the pending capture request, if any. Only one run answers each request.
+BLUEPRINTAUTOLAYOUT_API bool TakeLayoutCaptureRequest(FString &OutFilename);
+} // namespace GraphLayout
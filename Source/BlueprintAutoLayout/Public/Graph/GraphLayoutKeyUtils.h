@@ -69,5 +69,18 @@ inline FString BuildPinKeyString(const FNodeKey &NodeKey, const TCHAR *Direction
     return FString::Printf(TEXT("%s|%s|%s|%d"), *BuildNodeKeyString(NodeKey),
                            DirectionLabel, *PinName.ToString(), PinIndex);
 }
+// Pack a node key ordinal, pin direction and pin index into one 64-bit pin id.
+// Ids sort by owner ordinal first, so ordering follows the node key order.
+inline uint64 MakePinId(int32 NodeOrdinal, int32 Direction, int32 PinIndex)
+{
+    return (static_cast<uint64>(static_cast<uint32>(NodeOrdinal)) << 32) |
+           (static_cast<uint64>(Direction & 1) << 31) |
+           (static_cast<uint64>(static_cast<uint32>(PinIndex)) & 0x7fffffffull);
+}
+
+inline FString BuildEdgeKeyString(const FEdgeKey &Key)
+{
+    return FString::Printf(TEXT("%016llx->%016llx"), Key.SrcPin, Key.DstPin);
+}
 } // namespace KeyUtils
 } // namespace GraphLayout
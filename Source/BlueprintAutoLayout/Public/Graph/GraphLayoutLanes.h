@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for lane coarsening inputs.
+#include "CoreMinimal.h"
+
+// Layout node, edge, and stats definitions.
+#include "Graph/GraphLayout.h"
+
+// Crossing reduction parameters shared with the Sugiyama pipeline.
+#include "Graph/GraphLayoutSugiyama.h"
+
+// Two-level lane/junction ordering for large exec graphs.
+namespace GraphLayout
+{
+// Sugiyama inputs shared by the lane graph and every in-lane pass.
+struct FLaneLayoutParams
+{
+    FCrossingReductionParams Crossing;
+    int32 VariableGetMinLength = 1;
+};
+
+// Assign GlobalRank and GlobalOrder through the lane/junction coarsening of
+// SPEC 2-4. Junctions and lanes become single nodes of a lane graph, and each
+// lane's members, plus the data nodes nearest to them, are layered and ordered
+// on their own in parallel. The lane graph order and member ranks are then
+// composed into global ranks without reordering blocks. Incremental seeding does
+// not apply to these passes. Returns false, leaving Nodes untouched, when the
+// component has no exec nodes to coarsen.
+bool AssignCoarsenedRankOrders(TArrayView<FLayoutNode> Nodes,
+                               TConstArrayView<FLayoutEdge> Edges,
+                               const FLaneLayoutParams &Params, FLayoutStats &Stats);
+} // namespace GraphLayout
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for constraint storage.
+#include "CoreMinimal.h"
+
+// Arena-backed containers for transient solver state.
+#include "Graph/GraphLayoutArena.h"
+
+// Difference-constraint solving for maxLen layer assignment.
+namespace GraphLayout
+{
+// One difference constraint: rank[Dst] >= rank[Src] + Weight.
+struct FLayerConstraint
+{
+    int32 Src = INDEX_NONE;
+    int32 Dst = INDEX_NONE;
+    int32 Weight = 0;
+};
+
+// Flat constraint system. Constraints keep their deterministic list order, and the
+// CSR ranges index them by source and by destination in that same order.
+struct FLayerConstraintSystem
+{
+    int32 NodeCount = 0;
+    TLayoutArray<FLayerConstraint> Constraints;
+    TLayoutArray<int32> SrcOffsets;
+    TLayoutArray<int32> SrcConstraints;
+    TLayoutArray<int32> DstOffsets;
+    TLayoutArray<int32> DstConstraints;
+};
+
+// Counters reported by the solvers for verbose logs.
+struct FLayerConstraintStats
+{
+    int32 Visits = 0;
+    int32 Relaxations = 0;
+    bool bFeasible = true;
+};
+
+// Take ownership of a finished constraint list and build its CSR ranges.
+void BuildLayerConstraintSystem(int32 NodeCount,
+                                TLayoutArray<FLayerConstraint> &&Constraints,
+                                FLayerConstraintSystem &OutSystem);
+
+// Raise ranks to the least solution with queue-based Bellman-Ford (SPFA). Sources
+// are seeded in list order and visited FIFO, so a list in topological order is
+// solved with one visit per node. More than NodeCount visits to one node means a
+// positive cycle; the ranks are then restored and one forward pass in list order
+// is kept instead.
+FLayerConstraintStats SolveLayerLowerBounds(const FLayerConstraintSystem &System,
+                                            TLayoutArray<int32> &InOutRanks);
+
+// Pull every constraint source toward its nearest destination without lowering it:
+// rank[Src] = max(rank[Src], min(rank[Dst] - Weight)). Sources are seeded in
+// SeedOrder and requeued when a destination moves, so seeding in reverse
+// topological order settles each source in one visit.
+FLayerConstraintStats PullLayerSources(const FLayerConstraintSystem &System,
+                                       const TLayoutArray<int32> &SeedOrder,
+                                       TLayoutArray<int32> &InOutRanks);
+} // namespace GraphLayout
@@ -8,31 +8,70 @@
 
 // Layout node and edge definitions for placement.
 #include "Graph/GraphLayout.h"
+#include "Graph/GraphLayoutArena.h"
 
 // Placement utilities for layout passes.
 namespace GraphLayout
 {
-// Output of a global placement pass.
+// Output of a global placement pass. Positions are index-aligned with the placed
+// nodes and live in the current layout arena.
 struct FGlobalPlacement
 {
-    TMap<int32, FVector2f> Positions;
+    TLayoutArray<FVector2f> Positions;
     int32 AnchorNodeIndex = INDEX_NONE;
 };
 
-// Place nodes by rank order using standard or compact strategies.
+// Column geometry shared by the placement engines, indexed by rank.
+struct FRankColumns
+{
+    TLayoutArray<float> XLeft;
+    TLayoutArray<float> Width;
+};
+
+// Size each rank's column by its widest node and largest spacing. Spacing inputs
+// must already be clamped to non-negative values.
+void BuildRankColumns(TConstArrayView<FLayoutNode> Nodes, float NodeSpacingXExec,
+                      float NodeSpacingXData, FRankColumns &OutColumns);
+
+// Left edge of a node within its column for the configured alignment.
+float GetColumnAlignedX(const FRankColumns &Columns, const FLayoutNode &Node,
+                        EBlueprintAutoLayoutRankAlignment RankAlignment,
+                        EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment);
+
+// Group node indices by rank, each rank sorted by order and then stable key.
+void BuildSortedRankNodes(TConstArrayView<FLayoutNode> Nodes,
+                          FLayoutIndexLists &OutRankNodes);
+
+// Choose one incoming exec edge per node to align it with; INDEX_NONE when the
+// node has none. Adjacent-rank sources with the smallest order win, then stable
+// key and pin tie-breaks. Reroute sources are never chosen.
+void SelectExecAlignmentEdges(TConstArrayView<FLayoutNode> Nodes,
+                              TConstArrayView<FLayoutEdge> Edges,
+                              TLayoutArray<int32> &OutEdgeIndex);
+
+// Pick the node whose original position anchors the layout: rank 0 order 0 when
+// present, preferring exec nodes, then stable key, then index.
+int32 SelectPlacementAnchor(TConstArrayView<FLayoutNode> Nodes);
+
+// Place nodes by rank order using standard, compact, or Brandes-Koepf strategies.
 FGlobalPlacement PlaceGlobalRankOrder(
-    const TArray<FLayoutNode> &Nodes, float NodeSpacingXExec, float NodeSpacingXData,
-    float NodeSpacingYExec, float NodeSpacingYData,
+    TConstArrayView<FLayoutNode> Nodes, float NodeSpacingXExec,
+    float NodeSpacingXData, float NodeSpacingYExec, float NodeSpacingYData,
     EBlueprintAutoLayoutRankAlignment RankAlignment,
     EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment);
 FGlobalPlacement PlaceGlobalRankOrderCompact(
-    const TArray<FLayoutNode> &Nodes, const TArray<FLayoutEdge> &Edges,
+    TConstArrayView<FLayoutNode> Nodes, TConstArrayView<FLayoutEdge> Edges,
     float NodeSpacingXExec, float NodeSpacingXData, float NodeSpacingYExec,
     float NodeSpacingYData, bool bAlignExecChainsHorizontally,
     EBlueprintAutoLayoutRankAlignment RankAlignment,
     EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment);
+FGlobalPlacement PlaceGlobalRankOrderBrandesKoepf(
+    TConstArrayView<FLayoutNode> Nodes, TConstArrayView<FLayoutEdge> Edges,
+    float NodeSpacingXExec, float NodeSpacingXData, float NodeSpacingYExec,
+    float NodeSpacingYData, EBlueprintAutoLayoutRankAlignment RankAlignment,
+    EBlueprintAutoLayoutRankAlignment VariableGetRankAlignment);
 
 // Compute the offset that aligns the chosen anchor node to its original position.
-FVector2f ComputeGlobalAnchorOffset(const TArray<FLayoutNode> &Nodes,
+FVector2f ComputeGlobalAnchorOffset(TConstArrayView<FLayoutNode> Nodes,
                                     const FGlobalPlacement &Placement);
 } // namespace GraphLayout
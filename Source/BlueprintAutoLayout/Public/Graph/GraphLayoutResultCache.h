@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for cache keys and entries.
+#include "CoreMinimal.h"
+
+// Layout node, edge, and settings definitions.
+#include "Graph/GraphLayout.h"
+
+// Placement output stored by the cache.
+#include "Graph/GraphLayoutPlacement.h"
+
+// Component layout result caching keyed by structure.
+namespace GraphLayout
+{
+// Canonical identity of a working component. KeyOrder lists node indices by
+// ascending node key so cached positions map back onto any node id assignment.
+struct FComponentLayoutSignature
+{
+    uint64 Hash = 0;
+    TLayoutArray<int32> KeyOrder;
+};
+
+// Hash every layout input in node key order: keys, sizes, pin counts, flags, edge
+// stable keys, kinds, pin names, and the settings that affect placement. Returns
+// false when two nodes share a key, since key order then cannot identify nodes.
+bool BuildComponentLayoutSignature(TConstArrayView<FLayoutNode> Nodes,
+                                   TConstArrayView<FLayoutEdge> Edges,
+                                   const FLayoutSettings &Settings,
+                                   FComponentLayoutSignature &OutSignature);
+
+// Copy a cached placement for this signature, remapped onto current node indices.
+// Positions are relative to the layout origin; callers re-anchor them.
+bool FindCachedComponentLayout(const FComponentLayoutSignature &Signature,
+                               FGlobalPlacement &OutPlacement);
+
+// Store a placement for this signature, replacing the least recently used entry
+// when the cache is full. Safe to call from parallel component layouts.
+void StoreCachedComponentLayout(const FComponentLayoutSignature &Signature,
+                                const FGlobalPlacement &Placement);
+
+// Rank and order a Sugiyama node ended with in its last incremental run. The
+// signature captures the node's pin counts and links when it was recorded.
+struct FPriorNodeOrder
+{
+    int32 Rank = INDEX_NONE;
+    int32 Order = INDEX_NONE;
+    uint64 Signature = 0;
+};
+
+// Read prior orders for stable node identities; unknown identities keep a rank of
+// INDEX_NONE in OutOrders.
+void FindPriorNodeOrders(TConstArrayView<uint64> Identities,
+                         TLayoutArray<FPriorNodeOrder> &OutOrders);
+
+// Record orders from a finished run, replacing older records of the same nodes.
+void StorePriorNodeOrders(TConstArrayView<uint64> Identities,
+                          TConstArrayView<FPriorNodeOrder> Orders);
+
+// Drop every cached component layout and prior node order.
+void ClearComponentLayoutCache();
+} // namespace GraphLayout
@@ -4,7 +4,10 @@
 
 #include "CoreMinimal.h"
 
+#include "BlueprintAutoLayoutLog.h"
+#include "BlueprintAutoLayoutTrace.h"
 #include "Graph/GraphLayout.h"
+#include "Graph/GraphLayoutArena.h"
 #include "Graph/GraphLayoutKeyUtils.h"
 
 namespace GraphLayout
@@ -30,6 +33,11 @@ inline FString BuildNodeKeyString(const FNodeKey &Key)
     return KeyUtils::BuildNodeKeyString(Key);
 }
 
+inline FString BuildEdgeKeyString(const FEdgeKey &Key)
+{
+    return KeyUtils::BuildEdgeKeyString(Key);
+}
+
 enum class EPinDirection : uint8
 {
     Input = 0,
@@ -74,46 +82,93 @@ inline FString BuildPinKeyString(const FPinKey &Key)
     return KeyUtils::BuildPinKeyString(Key.NodeKey, Dir, Key.PinName, Key.PinIndex);
 }
 
-// Data used by the Sugiyama-style layered layout.
+// Crossing reduction inputs shared by component and lane layouts.
+struct FCrossingReductionParams
+{
+    EBlueprintAutoLayoutCrossingReduction Engine =
+        EBlueprintAutoLayoutCrossingReduction::Barycenter;
+
+    // Barycenter schedule.
+    int32 NumSweeps = 0;
+    bool bAdaptiveSweeps = false;
+    bool bVirtualChains = false;
+
+    // Median rounds and wall-time cap; a time budget of zero or less is unlimited.
+    int32 MaxIterations = 0;
+    double TimeBudgetMs = 0.0;
+};
+
+// Data used by the Sugiyama-style layered layout. Dummies share this layout, so it
+// holds no names; logs identify nodes by key.
 struct FSugiyamaNode
 {
     int32 Id = INDEX_NONE;
     FNodeKey Key;
-    FString Name;
     int32 OutputPinCount = 0;
     int32 InputPinCount = 0;
     int32 ExecOutputPinCount = 0;
     int32 ExecInputPinCount = 0;
-    bool bHasExecPins = false;
-    bool bIsVariableGet = false;
-    bool bIsReroute = false;
     FVector2f Size = FVector2f::ZeroVector;
     int32 Rank = 0;
     int32 Order = 0;
-    bool bIsDummy = false;
     int32 SourceIndex = INDEX_NONE;
+    bool bHasExecPins = false;
+    bool bIsVariableGet = false;
+    bool bIsReroute = false;
+    bool bIsDummy = false;
 };
 
+// Pin identities of an edge as it entered the graph.
+struct FSugiyamaEdgePins
+{
+    FPinKey Src;
+    FPinKey Dst;
+};
+
+// Pin keys live in FSugiyamaGraph::EdgePins; read them through GetEdgeSrcPin and
+// GetEdgeDstPin. Segments of a split long edge share the long edge's row and
+// record their chain and segment step instead.
 struct FSugiyamaEdge
 {
     int32 Src = INDEX_NONE;
     int32 Dst = INDEX_NONE;
-    FPinKey SrcPin;
-    FPinKey DstPin;
+    int32 PinsIndex = INDEX_NONE;
+    int32 Chain = INDEX_NONE;
+    int32 ChainStep = 0;
     int32 SrcPinIndex = 0;
     int32 DstPinIndex = 0;
-    EEdgeKind Kind = EEdgeKind::Data;
-    FString StableKey;
     int32 MinLen = 1;
+    FEdgeKey StableKey;
+    EEdgeKind Kind = EEdgeKind::Data;
     bool bReversed = false;
 };
 
+// Dummy run that replaces one long edge. Its dummies are the contiguous nodes
+// [FirstNode, FirstNode + NodeCount) in ascending rank order, joined by segments
+// with ChainStep 0 (from Src) through NodeCount (into Dst).
+struct FSugiyamaChain
+{
+    int32 EdgeOrdinal = INDEX_NONE;
+    int32 Src = INDEX_NONE;
+    int32 Dst = INDEX_NONE;
+    int32 FirstNode = INDEX_NONE;
+    int32 NodeCount = 0;
+};
+
+// Pipeline working graph; its arrays live in the current layout arena.
 struct FSugiyamaGraph
 {
-    TArray<FSugiyamaNode> Nodes;
-    TArray<FSugiyamaEdge> Edges;
+    TLayoutArray<FSugiyamaNode> Nodes;
+    TLayoutArray<FSugiyamaEdge> Edges;
+    TLayoutArray<FSugiyamaEdgePins> EdgePins;
+    TLayoutArray<FSugiyamaChain> Chains;
 };
 
+// Resolve an edge's pin keys. Segments build the pin on a dummy side on demand
+// from the dummy's key rather than storing it.
+FPinKey GetEdgeSrcPin(const FSugiyamaGraph &Graph, const FSugiyamaEdge &Edge);
+FPinKey GetEdgeDstPin(const FSugiyamaGraph &Graph, const FSugiyamaEdge &Edge);
+
 inline int32 CountDummyNodes(const FSugiyamaGraph &Graph)
 {
     int32 Count = 0;
@@ -125,9 +180,11 @@ inline int32 CountDummyNodes(const FSugiyamaGraph &Graph)
     return Count;
 }
 
+// Detail dumps build key strings, so they also require a verbose trace sink.
 inline bool ShouldDumpDetail(int32 NodeCount, int32 EdgeCount)
 {
-    return NodeCount <= kVerboseDumpNodeLimit && EdgeCount <= kVerboseDumpEdgeLimit;
+    return NodeCount <= kVerboseDumpNodeLimit && EdgeCount <= kVerboseDumpEdgeLimit &&
+           LAYOUT_TRACE_ACTIVE(Verbose);
 }
 
 inline bool ShouldDumpSugiyamaDetail(const FSugiyamaGraph &Graph)
@@ -135,8 +192,91 @@ inline bool ShouldDumpSugiyamaDetail(const FSugiyamaGraph &Graph)
     return ShouldDumpDetail(Graph.Nodes.Num(), Graph.Edges.Num());
 }
 
+// Rank node keys once so hot loops compare integers instead of GUIDs. Equal keys
+// share an ordinal. OutKeyOrder lists node indices by ascending key, then index.
+void BuildNodeKeyOrdinals(const FSugiyamaGraph &Graph,
+                          TLayoutArray<int32> &OutOrdinals,
+                          TLayoutArray<int32> &OutKeyOrder);
+
+// Binary min-heap of node indices ordered by NodeKey ordinal, then node index.
+class FNodeKeyQueue
+{
+  public:
+    explicit FNodeKeyQueue(const TLayoutArray<int32> &InOrdinals)
+        : Ordinals(InOrdinals)
+    {
+    }
+
+    bool IsEmpty() const
+    {
+        return Heap.IsEmpty();
+    }
+
+    void Push(int32 NodeIndex)
+    {
+        Heap.HeapPush(NodeIndex, FLess{Ordinals});
+    }
+
+    int32 Pop()
+    {
+        int32 NodeIndex = INDEX_NONE;
+        Heap.HeapPop(NodeIndex, FLess{Ordinals}, EAllowShrinking::No);
+        return NodeIndex;
+    }
+
+  private:
+    struct FLess
+    {
+        const TLayoutArray<int32> &Ordinals;
+
+        bool operator()(int32 A, int32 B) const
+        {
+            if (Ordinals[A] != Ordinals[B]) {
+                return Ordinals[A] < Ordinals[B];
+            }
+            return A < B;
+        }
+    };
+
+    const TLayoutArray<int32> &Ordinals;
+    TLayoutArray<int32> Heap;
+};
+
+void RemoveCycles(FSugiyamaGraph &Graph, const TCHAR *Label);
 void AssignInitialOrder(FSugiyamaGraph &Graph, int32 MaxRank,
-                        TArray<TArray<int32>> &RankNodes, const TCHAR *Label);
-void RunCrossingReduction(FSugiyamaGraph &Graph, int32 MaxRank, int32 NumSweeps,
-                          TArray<TArray<int32>> &RankNodes, const TCHAR *Label);
+                        FLayoutIndexLists &RankNodes, const TCHAR *Label);
+// Seed incremental runs: nodes with a prior order (not INDEX_NONE) are re-sorted
+// by it within the rank slots they occupy after AssignInitialOrder.
+void ApplyPriorOrders(FSugiyamaGraph &Graph, FLayoutIndexLists &RankNodes,
+                      const TLayoutArray<int32> &PriorOrders, const TCHAR *Label);
+// Fixed mode runs exactly NumSweeps rounds. Adaptive mode treats NumSweeps as an
+// upper bound and stops once orders are stable or crossings stop decreasing.
+// Virtual chains order every dummy of a long edge by the relative position of the
+// chain endpoint the sweep comes from, so each chain moves as one entity.
+// SweepRanks, when set, limits reordering to ranks flagged true. Returns the number
+// of sweep rounds run; OutCrossings, when set, receives the final crossing count.
+int32 RunCrossingReduction(FSugiyamaGraph &Graph, int32 MaxRank, int32 NumSweeps,
+                           bool bAdaptiveSweeps, bool bVirtualChains,
+                           FLayoutIndexLists &RankNodes, const TCHAR *Label,
+                           const TLayoutArray<bool> *SweepRanks = nullptr,
+                           int64 *OutCrossings = nullptr);
+// Weighted-median rounds, alternating forward and backward, each followed by
+// adjacent exchanges (transpose) that swap neighbors while that strictly lowers
+// crossings. Stops after MaxIterations rounds, once the time budget is spent, or
+// at zero crossings, and keeps the order with the fewest crossings. Ties break by
+// NodeKey, so runs bounded by iterations alone are deterministic. Returns the
+// rounds run and reports the final crossings and the swaps made.
+int32 RunMedianCrossingReduction(FSugiyamaGraph &Graph, int32 MaxRank,
+                                 const FCrossingReductionParams &Params,
+                                 FLayoutIndexLists &RankNodes, const TCHAR *Label,
+                                 const TLayoutArray<bool> *SweepRanks,
+                                 int64 &OutCrossings, int32 &OutSwaps);
+
+// Copy working nodes and edges into a Sugiyama graph; node I keeps SourceIndex I.
+void BuildSugiyamaGraph(TConstArrayView<FLayoutNode> Nodes,
+                        TConstArrayView<FLayoutEdge> Edges, FSugiyamaGraph &OutGraph);
+// Break cycles, layer, split long edges, and order. Returns the highest rank.
+int32 RunSugiyama(FSugiyamaGraph &Graph, const FCrossingReductionParams &Crossing,
+                  bool bIncremental, const TCHAR *Label, int32 VariableGetMinLength,
+                  FLayoutStats &Stats);
 } // namespace GraphLayout
@@ -5,10 +5,17 @@
 
 // Core UE types for editor utilities.
 #include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 // Default values for layout settings.
 #include "BlueprintAutoLayoutDefaults.h"
 
+// Layout engine input and output types.
+#include "Graph/GraphLayout.h"
+
+// Atomics shared between the editor and background layout tasks.
+#include <atomic>
+
 // Forward declarations for Blueprint editor types.
 class UBlueprint;
 class UEdGraph;
@@ -39,6 +46,48 @@ struct BLUEPRINTAUTOLAYOUT_API FAutoLayoutSettings
         BlueprintAutoLayout::Defaults::DefaultVariableGetRankAlignment;
     bool bAlignExecChainsHorizontally =
         BlueprintAutoLayout::Defaults::DefaultAlignExecChainsHorizontally;
+    EBlueprintAutoLayoutPlacement Placement =
+        BlueprintAutoLayout::Defaults::DefaultPlacement;
+
+    // Crossing reduction schedule; fixed sweeps unless adaptive mode is enabled.
+    bool bAdaptiveCrossingReduction =
+        BlueprintAutoLayout::Defaults::DefaultAdaptiveCrossingReduction;
+    int32 MaxAdaptiveCrossingSweeps =
+        BlueprintAutoLayout::Defaults::DefaultMaxAdaptiveCrossingSweeps;
+    // Order long-edge dummy chains as single entities during sweeps.
+    bool bVirtualLongEdgeChains =
+        BlueprintAutoLayout::Defaults::DefaultVirtualLongEdgeChains;
+    // Ordering heuristic and its budget. MaxIterations bounds median rounds; a
+    // positive time budget also stops them early, at a machine-dependent point.
+    EBlueprintAutoLayoutCrossingReduction CrossingReduction =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReduction;
+    int32 CrossingReductionMaxIterations =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReductionMaxIterations;
+    float CrossingReductionTimeBudgetMs =
+        BlueprintAutoLayout::Defaults::DefaultCrossingReductionTimeBudgetMs;
+    // Lay out lanes and junctions first, then each lane's members, on components
+    // with at least CoarsenExecLanesMinNodes nodes.
+    bool bCoarsenExecLanes = BlueprintAutoLayout::Defaults::DefaultCoarsenExecLanes;
+    int32 CoarsenExecLanesMinNodes =
+        BlueprintAutoLayout::Defaults::DefaultCoarsenExecLanesMinNodes;
+
+    // Reuse placements of structurally identical components from earlier runs.
+    bool bCacheComponentLayouts =
+        BlueprintAutoLayout::Defaults::DefaultCacheComponentLayouts;
+    // Seed orders from the previous run and re-sweep only ranks near edits.
+    bool bIncrementalLayout = BlueprintAutoLayout::Defaults::DefaultIncrementalLayout;
+};
+
+// Per-run counters and stage times, summed over every component.
+struct BLUEPRINTAUTOLAYOUT_API FAutoLayoutStats
+{
+    GraphLayout::FLayoutStats Layout;
+    int32 Components = 0;
+
+    // Editor-side stage times in milliseconds.
+    double PrepareMs = 0.0;
+    double ComputeMs = 0.0;
+    double CommitMs = 0.0;
 };
 
 // Result payload for auto layout execution.
@@ -48,9 +97,81 @@ struct BLUEPRINTAUTOLAYOUT_API FAutoLayoutResult
     FString Error;
     FString Guidance;
     int32 NodesLaidOut = 0;
+
+    // Laid out nodes whose rounded position changed; only these were committed.
+    int32 NodesMoved = 0;
     int32 ComponentsLaidOut = 0;
+    FAutoLayoutStats Stats;
+};
+
+// Layout input captured from the editor on the game thread plus the computed output.
+// The compute step reads only engine types, so it may run on any thread.
+struct BLUEPRINTAUTOLAYOUT_API FAutoLayoutJob
+{
+    // Editor objects the job was captured from.
+    TWeakObjectPtr<UBlueprint> Blueprint;
+    TWeakObjectPtr<UEdGraph> Graph;
+    TArray<TWeakObjectPtr<UEdGraphNode>> LayoutIdToNode;
+
+    // Checksum of the captured nodes; commit rejects the job if it changed.
+    uint32 GraphChecksum = 0;
+
+    // Layout engine input.
+    GraphLayout::FLayoutGraph LayoutGraph;
+    TArray<TArray<int32>> Components;
+    GraphLayout::FLayoutSettings LayoutSettings;
+
+    // Per-component output filled by ComputeAutoLayout.
+    TArray<GraphLayout::FLayoutComponentResult> ComponentResults;
+    TArray<FString> ComponentErrors;
+    TArray<bool> ComponentSucceeded;
+
+    // Stats filled by the prepare and compute steps.
+    FAutoLayoutStats Stats;
 };
 
+// Progress and cancellation shared with a background compute step.
+struct FAutoLayoutProgress
+{
+    std::atomic<bool> bCancelRequested{false};
+    std::atomic<int32> CompletedComponents{0};
+};
+
+// How PrepareAutoLayout finds a graph panel to measure node widgets from.
+enum class EAutoLayoutPanelMode : uint8
+{
+    // Open the Blueprint editor and bring the graph to front to get a panel.
+    OpenEditor,
+    // Use a panel only if the graph is already shown in an editor; otherwise size
+    // nodes from the size cache and estimates. Never opens or focuses a tab.
+    ExistingOnly
+};
+
+// Game thread: validate the selection, size nodes, and capture the layout input.
+BLUEPRINTAUTOLAYOUT_API bool
+PrepareAutoLayout(UBlueprint *Blueprint, UEdGraph *Graph,
+                  const TArray<UEdGraphNode *> &StartNodes,
+                  const FAutoLayoutSettings &Settings, FAutoLayoutJob &OutJob,
+                  FAutoLayoutResult &OutResult,
+                  EAutoLayoutPanelMode PanelMode = EAutoLayoutPanelMode::OpenEditor);
+
+// Any thread: run the layout engine for every captured component.
+BLUEPRINTAUTOLAYOUT_API void ComputeAutoLayout(FAutoLayoutJob &Job,
+                                               FAutoLayoutProgress *Progress = nullptr);
+
+// Any thread, time-sliced: lay out components from InOutNextComponent (0 starts a
+// new pass) until BudgetSeconds are spent, then return so the caller can resume
+// later. A component is never split, so one slice may overrun the budget by the
+// cost of its last component. Returns true once every component is computed.
+BLUEPRINTAUTOLAYOUT_API bool ComputeAutoLayoutSlice(FAutoLayoutJob &Job,
+                                                    int32 &InOutNextComponent,
+                                                    double BudgetSeconds);
+
+// Game thread: apply the computed positions in one transaction. Fails without
+// touching the graph when the captured nodes were deleted, moved, or relinked.
+BLUEPRINTAUTOLAYOUT_API bool CommitAutoLayout(const FAutoLayoutJob &Job,
+                                              FAutoLayoutResult &OutResult);
+
 // Auto layout islands in the provided graph, seeded by the selected nodes.
 BLUEPRINTAUTOLAYOUT_API bool AutoLayoutIslands(UBlueprint *Blueprint, UEdGraph *Graph,
                                                const TArray<UEdGraphNode *> &StartNodes,
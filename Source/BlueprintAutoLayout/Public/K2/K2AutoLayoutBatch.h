@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for batch inputs and results.
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+// Layout settings and single-graph layout API.
+#include "K2/K2AutoLayout.h"
+
+// Forward declarations for Blueprint editor types.
+class UBlueprint;
+class UEdGraph;
+
+// Headless auto-layout over whole Blueprints and asset sets.
+namespace K2AutoLayout
+{
+// Totals reported by a batch run.
+struct BLUEPRINTAUTOLAYOUT_API FBatchAutoLayoutResult
+{
+    int32 AssetsProcessed = 0;
+    int32 AssetsSaved = 0;
+    int32 GraphsLaidOut = 0;
+    int32 GraphsSkipped = 0;
+    int32 NodesLaidOut = 0;
+    TArray<FString> Errors;
+};
+
+// Controls for asset batches.
+struct BLUEPRINTAUTOLAYOUT_API FBatchAutoLayoutOptions
+{
+    // Save each package whose graphs moved.
+    bool bSave = true;
+
+    // Assets whose layout may compute on worker threads at the same time.
+    int32 MaxAssetsInFlight = 4;
+};
+
+// Collect every editable K2 graph of a Blueprint in a stable order.
+BLUEPRINTAUTOLAYOUT_API void CollectLayoutGraphs(UBlueprint *Blueprint,
+                                                 TArray<UEdGraph *> &OutGraphs);
+
+// Game thread: lay out every island of every graph in a loaded Blueprint. Sizes come
+// from open graph widgets when present and from the node size cache otherwise.
+BLUEPRINTAUTOLAYOUT_API bool
+AutoLayoutBlueprintGraphs(UBlueprint *Blueprint, const FAutoLayoutSettings &Settings,
+                          FBatchAutoLayoutResult &OutResult);
+
+// Game thread: load, lay out, and optionally save Blueprint assets in path order.
+// Load, commit, and save stay on the game thread; layout compute for up to
+// MaxAssetsInFlight assets runs on worker threads meanwhile.
+BLUEPRINTAUTOLAYOUT_API bool AutoLayoutBlueprintAssets(
+    const TArray<FSoftObjectPath> &AssetPaths, const FAutoLayoutSettings &Settings,
+    const FBatchAutoLayoutOptions &Options, FBatchAutoLayoutResult &OutResult);
+} // namespace K2AutoLayout
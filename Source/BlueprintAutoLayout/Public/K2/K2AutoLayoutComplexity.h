@@ -13,10 +13,17 @@ class UEdGraphNode;
 // Cyclomatic complexity helpers for Blueprint graphs.
 namespace K2AutoLayout
 {
-// Compute cyclomatic complexity using linked exec output pin counts.
+// Compute cyclomatic complexity using linked exec output pin counts. Served from
+// a per-graph index kept current by graph change notifications and node
+// modifications; game thread only.
 BLUEPRINTAUTOLAYOUT_API int32 CalculateCyclomaticComplexity(const UEdGraph *Graph);
 
-// Compute cyclomatic complexity for islands containing selected nodes.
+// Compute cyclomatic complexity for islands containing selected nodes. Costs
+// O(selection) once the graph's index is current.
 BLUEPRINTAUTOLAYOUT_API int32 CalculateCyclomaticComplexityForSelectionIslands(
     const UEdGraph *Graph, const TArray<const UEdGraphNode *> &SelectedNodes);
+
+// Hook and release the editor notifications that keep complexity indices current.
+void StartupComplexityIndex();
+void ShutdownComplexityIndex();
 } // namespace K2AutoLayout
@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for sizes, GUIDs, and node sets.
+#include "CoreMinimal.h"
+
+// Forward declarations for panel and node inputs.
+class SGraphPanel;
+class UEdGraphNode;
+
+// Live widget geometry captured for auto-layout runs.
+namespace K2AutoLayout
+{
+// Sizes of the requested node widgets on a graph panel, read in one pass over the
+// panel's children. Entries point at nodes owned by the panel's graph and are only
+// valid until that graph or its widgets change.
+struct FNodeGeometrySnapshot
+{
+    // Geometry of one node widget.
+    struct FNode
+    {
+        const UEdGraphNode *Node = nullptr;
+        uint32 PinSignature = 0;
+        FVector2f AbsoluteSize = FVector2f::ZeroVector;
+        FVector2f DesiredSize = FVector2f::ZeroVector;
+
+        // Per-axis max of the absolute and desired sizes; zero when neither is usable.
+        FVector2f Size = FVector2f::ZeroVector;
+    };
+
+    TArray<FNode> Nodes;
+    TMap<FGuid, int32> NodeIndexByGuid;
+
+    // Find the entry captured for a node, or null when it had no widget.
+    const FNode *Find(const UEdGraphNode *Node) const;
+};
+
+// Replace OutSnapshot with the geometry of the panel's widgets for Nodes. Widgets
+// of other nodes are skipped, so the cost follows Nodes rather than the graph.
+void CaptureNodeGeometry(SGraphPanel &Panel, const TSet<UEdGraphNode *> &Nodes,
+                         FNodeGeometrySnapshot &OutSnapshot);
+
+// Feed every usable size in the snapshot to the node size cache.
+void RecordMeasuredNodeSizes(const FNodeGeometrySnapshot &Snapshot);
+} // namespace K2AutoLayout
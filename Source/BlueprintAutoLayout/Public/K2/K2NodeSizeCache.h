@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Ensure the header is included only once.
+#pragma once
+
+// Core UE types for size and signature values.
+#include "CoreMinimal.h"
+
+// Forward declaration for node inputs.
+class UEdGraphNode;
+
+// Node size caching shared by auto-layout runs.
+namespace K2AutoLayout
+{
+// Stable hash of the node's visible pin layout (direction, name, and type of every
+// pin). Any pin change produces a different signature and invalidates cached sizes.
+uint32 ComputeNodePinSignature(const UEdGraphNode *Node);
+
+// Read the last measured size of this node instance when its pins are unchanged.
+bool TryGetCachedNodeSize(const UEdGraphNode *Node, uint32 PinSignature,
+                          FVector2f &OutSize);
+
+// Read a size measured on another node with the same class and pin signature.
+bool TryGetEstimatedNodeSize(const UEdGraphNode *Node, uint32 PinSignature,
+                             FVector2f &OutSize);
+
+// Store a fresh widget measurement in the instance cache and the estimate table.
+// Newer measurements replace older ones so shrunk nodes do not stay oversized.
+void RecordMeasuredNodeSize(const UEdGraphNode *Node, uint32 PinSignature,
+                            const FVector2f &Size);
+
+// Drop the cached instance size for a node that was edited or reconstructed.
+void InvalidateCachedNodeSize(const UEdGraphNode *Node);
+
+// Load persisted estimates and hook invalidation; called on module startup.
+void StartupNodeSizeCache();
+
+// Save estimates under Saved/ and unhook invalidation; called on module shutdown.
+void ShutdownNodeSizeCache();
+} // namespace K2AutoLayout